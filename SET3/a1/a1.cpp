@@ -1,6 +1,102 @@
 #include <iostream>
 #include <random>
 #include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+struct Circle {
+    double x, y, r;
+};
+
+const double eps = 1e-12;
+
+bool sameCircle(const Circle& a, const Circle& b) {
+    return std::abs(a.x - b.x) < eps && std::abs(a.y - b.y) < eps && std::abs(a.r - b.r) < eps;
+}
+
+// Where circle o covers the boundary of circle c. All: c lies inside o. None: they are apart
+// or o lies inside c; tangency counts as either, since it touches a single point. Arc: o
+// covers the arc of c from angle from to angle to (counterclockwise, in [0, 2pi)).
+enum class Coverage { None, All, Arc };
+
+Coverage boundaryCoverage(const Circle& c, const Circle& o, double& from, double& to) {
+    double dx = o.x - c.x, dy = o.y - c.y;
+    double d = std::hypot(dx, dy);
+    if (d + c.r <= o.r + eps) {
+        return Coverage::All;
+    }
+    if (d >= c.r + o.r - eps || d + o.r <= c.r + eps) {
+        return Coverage::None;
+    }
+    double base = std::atan2(dy, dx);
+    double spread = std::acos(std::clamp((c.r * c.r + d * d - o.r * o.r) / (2 * c.r * d), -1.0, 1.0));
+    auto normalize = [](double a) { return std::fmod(std::fmod(a, 2 * M_PI) + 2 * M_PI, 2 * M_PI); };
+    from = normalize(base - spread);
+    to = normalize(base + spread);
+    return Coverage::Arc;
+}
+
+// Green's theorem term 1/2 * integral of (x dy - y dx) along circle c from angle a to b
+// (counterclockwise).
+double arcTerm(const Circle& c, double a, double b) {
+    return 0.5 * (c.r * c.x * (std::sin(b) - std::sin(a)) - c.r * c.y * (std::cos(b) - std::cos(a)) + c.r * c.r * (b - a));
+}
+
+// The boundary of an intersection (union) is made of the arcs of each circle that lie inside
+// (outside) all the others. For each circle, the arcs the other circles cover become +1/-1
+// events; a sweep over the sorted events keeps the stretches covered by every other circle
+// (by none), and the area is the sum of arcTerm over them. Holes in a union are traversed
+// clockwise and subtract themselves. Repeated circles are counted once. O(k^2 log k) for k
+// circles.
+double boundaryArea(const std::vector<Circle>& circles, bool unionArea) {
+    double area = 0;
+    for (size_t i = 0; i < circles.size(); ++i) {
+        const Circle& c = circles[i];
+        bool duplicate = false;
+        int others = 0, cover = 0;
+        std::vector<std::pair<double, int>> events;
+        for (size_t j = 0; j < circles.size(); ++j) {
+            if (j == i) continue;
+            if (sameCircle(c, circles[j])) {
+                duplicate = duplicate || j < i;
+                continue;
+            }
+            ++others;
+            double from, to;
+            Coverage coverage = boundaryCoverage(c, circles[j], from, to);
+            if (coverage == Coverage::All) {
+                ++cover;
+            } else if (coverage == Coverage::Arc) {
+                events.push_back({from, 1});
+                events.push_back({to, -1});
+                // An arc that wraps past angle 0 already covers the start of the sweep.
+                cover += from > to;
+            }
+        }
+        if (duplicate) continue;
+        std::sort(events.begin(), events.end());
+        events.push_back({2 * M_PI, 0});
+
+        double from = 0;
+        for (const auto& [angle, delta] : events) {
+            if (angle - from > eps && (unionArea ? cover == 0 : cover == others)) {
+                area += arcTerm(c, from, angle);
+            }
+            from = angle;
+            cover += delta;
+        }
+    }
+    return std::max(area, 0.0);
+}
+
+double intersectionArea(const std::vector<Circle>& circles) {
+    return circles.empty() ? 0 : boundaryArea(circles, false);
+}
+
+double unionArea(const std::vector<Circle>& circles) {
+    return boundaryArea(circles, true);
+}
 
 bool isInIntersection(double x, double y, double r1, double r2, double r3, double x1, double y1, double x2, double y2, double x3, double y3) {
 
@@ -23,7 +119,7 @@ void monteCarlo(int N, double r1, double r2, double r3,
     double downMax = std::min(y1 - r1, std::min(y2 - r2, y3 - r3));
     double sRecMax =  (rightMax - leftMax) * (upMax - downMax); 
     
-    double exact = 0.25 * M_PI + 1.25 * std::asin(0.8) - 1;
+    double exact = intersectionArea({{x1, y1, r1}, {x2, y2, r2}, {x3, y3, r3}});
     std::random_device rd;
     std::mt19937 gen(rd());
     int M = 0;
@@ -56,11 +152,171 @@ void monteCarlo(int N, double r1, double r2, double r3,
 
 } 
 
-int main() {
+bool isInIntersection(double x, double y, const std::vector<Circle>& circles) {
+    for (const Circle& c : circles) {
+        if ((x - c.x) * (x - c.x) + (y - c.y) * (y - c.y) > c.r * c.r) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Monte Carlo over the bounding box of the first circle, checked against the exact area on
+// random configurations of k circles. Prints: random config k N estimate exact relative error %.
+void randomConfigurations(int configs, int k, int N) {
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<> center(0.0, 2.0);
+    std::uniform_real_distribution<> radius(0.5, 2.0);
+    for (int config = 0; config < configs; ++config) {
+        std::vector<Circle> circles;
+        double exact = 0;
+        while (exact < eps) {
+            circles.clear();
+            for (int i = 0; i < k; ++i) {
+                circles.push_back({center(gen), center(gen), radius(gen)});
+            }
+            exact = intersectionArea(circles);
+        }
+        const Circle& first = circles[0];
+        std::uniform_real_distribution<> disX(first.x - first.r, first.x + first.r);
+        std::uniform_real_distribution<> disY(first.y - first.r, first.y + first.r);
+        int M = 0;
+        for (int i = 0; i < N; ++i) {
+            if (isInIntersection(disX(gen), disY(gen), circles)) {
+                M++;
+            }
+        }
+        double Se = (M / static_cast<double>(N)) * 4 * first.r * first.r;
+        std::cout << "random " << config << " " << k << " " << N << " " << Se << " " << exact << " "
+                  << (std::abs(exact - Se) / exact) * 100 << std::endl;
+    }
+}
+
+enum CellClass { Outside, Inside, Boundary };
+
+// Interval test of an axis-aligned cell against every circle: the nearest point of the cell
+// decides whether it misses a circle, the farthest corner whether it lies inside it.
+CellClass classifyCell(double x0, double y0, double x1, double y1, const std::vector<Circle>& circles, long& tests) {
+    bool inside = true;
+    for (const Circle& c : circles) {
+        ++tests;
+        double nx = std::clamp(c.x, x0, x1) - c.x, ny = std::clamp(c.y, y0, y1) - c.y;
+        if (nx * nx + ny * ny > c.r * c.r) {
+            return Outside;
+        }
+        double fx = std::max(c.x - x0, x1 - c.x), fy = std::max(c.y - y0, y1 - c.y);
+        if (fx * fx + fy * fy > c.r * c.r) {
+            inside = false;
+        }
+    }
+    return inside ? Inside : Boundary;
+}
+
+struct QuadtreeEstimate {
+    double inside = 0;
+    double boundary = 0;
+    double sampled = 0;
+    long cells = 0;
+    long tests = 0;
+    long evaluations = 0;
+    bool sampling = false;
+
+    // The true area lies in [inside, inside + boundary] whatever the sampling did.
+    double area() const {
+        return inside + (sampling ? sampled : boundary / 2);
+    }
+
+    double errorBound() const {
+        return sampling ? std::max(sampled, boundary - sampled) : boundary / 2;
+    }
+};
+
+void subdivide(double x0, double y0, double x1, double y1, int depth, const std::vector<Circle>& circles, int samples,
+               std::mt19937& gen, QuadtreeEstimate& estimate) {
+    ++estimate.cells;
+    CellClass cell = classifyCell(x0, y0, x1, y1, circles, estimate.tests);
+    double area = (x1 - x0) * (y1 - y0);
+    if (cell == Outside) {
+        return;
+    }
+    if (cell == Inside) {
+        estimate.inside += area;
+        return;
+    }
+    if (depth == 0) {
+        estimate.boundary += area;
+        if (samples > 0) {
+            std::uniform_real_distribution<> disX(x0, x1);
+            std::uniform_real_distribution<> disY(y0, y1);
+            int M = 0;
+            for (int i = 0; i < samples; ++i) {
+                if (isInIntersection(disX(gen), disY(gen), circles)) {
+                    M++;
+                }
+            }
+            estimate.sampled += (M / static_cast<double>(samples)) * area;
+            estimate.evaluations += samples;
+        }
+        return;
+    }
+    double mx = (x0 + x1) / 2, my = (y0 + y1) / 2;
+    subdivide(x0, y0, mx, my, depth - 1, circles, samples, gen, estimate);
+    subdivide(mx, y0, x1, my, depth - 1, circles, samples, gen, estimate);
+    subdivide(x0, my, mx, y1, depth - 1, circles, samples, gen, estimate);
+    subdivide(mx, my, x1, y1, depth - 1, circles, samples, gen, estimate);
+}
+
+// Deterministic unless samples > 0: cells proven inside count fully, cells proven outside are
+// dropped, and only boundary cells are split, down to maxDepth levels below the bounding box
+// of the intersection. Leftover boundary cells either count half (error bound half their
+// area) or are Monte Carlo sampled with samples points each.
+QuadtreeEstimate adaptiveArea(const std::vector<Circle>& circles, int maxDepth, int samples = 0) {
+    QuadtreeEstimate estimate;
+    estimate.sampling = samples > 0;
+    double left = -INFINITY, right = INFINITY, down = -INFINITY, up = INFINITY;
+    for (const Circle& c : circles) {
+        left = std::max(left, c.x - c.r);
+        right = std::min(right, c.x + c.r);
+        down = std::max(down, c.y - c.r);
+        up = std::min(up, c.y + c.r);
+    }
+    if (circles.empty() || left >= right || down >= up) {
+        return estimate;
+    }
+    std::mt19937 gen(2024);
+    subdivide(left, down, right, up, maxDepth, circles, samples, gen, estimate);
+    return estimate;
+}
+
+// Prints: adaptive depth samples area bound cells tests evaluations relative error %.
+void adaptiveSweep(const std::vector<Circle>& circles, int maxDepth, int samples) {
+    double exact = intersectionArea(circles);
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        QuadtreeEstimate estimate = adaptiveArea(circles, depth, samples);
+        std::cout << "adaptive " << depth << " " << samples << " " << estimate.area() << " " << estimate.errorBound() << " "
+                  << estimate.cells << " " << estimate.tests << " " << estimate.evaluations << " "
+                  << (std::abs(exact - estimate.area()) / exact) * 100 << std::endl;
+    }
+}
+
+// "./a1 random [configs] [k] [N]" runs the Monte Carlo on random configurations instead of the
+// fixed three circles; "./a1 adaptive [maxDepth] [samples]" runs the quadtree estimator on them.
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "random") {
+        randomConfigurations(argc > 2 ? std::stoi(argv[2]) : 1000, argc > 3 ? std::stoi(argv[3]) : 3,
+                             argc > 4 ? std::stoi(argv[4]) : 100000);
+        return 0;
+    }
+
     double r1 = 1.0, r2 = std::pow(5, 0.5) / 2, r3 = r2;
     double x1 = 1.0, y1 = 1.0; 
     double x2 = 1.5, y2 = 2.0;  
     double x3 = 2.0, y3 = 1.5; 
+    if (argc > 1 && std::string(argv[1]) == "adaptive") {
+        adaptiveSweep({{x1, y1, r1}, {x2, y2, r2}, {x3, y3, r3}}, argc > 2 ? std::stoi(argv[2]) : 16,
+                      argc > 3 ? std::stoi(argv[3]) : 0);
+        return 0;
+    }
     for (int N = 1000; N <= 100000; N+=500) {
         monteCarlo(N, r1, r2, r3, x1, y1, x2, y2, x3, y3);
     }
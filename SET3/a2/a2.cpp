@@ -4,31 +4,34 @@
 #include <algorithm>
 #include <chrono>
 #include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <tuple>
+
+#include "../../common/argsort.h"
+#include "../../common/datasetCache.h"
+#include "../../common/sweepRunner.h"
+#include "../../common/sortingNetworks.h"
 
 class ArrayGenerator {
 private:
-    std::mt19937 randEngine; 
+    DatasetCache datasets;
     const int maxSize = 10000; 
     const int minValue = 0;    
     const int maxValue = 6000; 
 
-    std::mt19937& getRandEngine() {
-        return randEngine;
+    // Every distribution is generated once at maxSize (or the largest size asked for) and
+    // cached on disk; shorter arrays are its prefixes.
+    std::vector<int> prefix(const std::string& name, int size, const DatasetCache::Maker<int>& make) {
+        const MappedDataset& dataset = datasets.ints(name, std::max(size, maxSize), make);
+        return std::vector<int>(dataset.ints(), dataset.ints() + size);
     }
 
 public:
-    ArrayGenerator() {
-        std::random_device randDevice;
-        randEngine = std::mt19937(randDevice());
-    }
-
     std::vector<int> generateRandomArray(int size, int minVal = 0, int maxVal = 6000) {
-        std::uniform_int_distribution<int> unif(minVal, maxVal);
-        std::vector<int> array(size);
-        for (int i = 0; i < size; ++i) {
-            array[i] = unif(randEngine);
-        }
-        return array;
+        return prefix("a2-random-" + std::to_string(minVal) + "-" + std::to_string(maxVal), size,
+                      [=](const WorkloadGenerator& workloads, size_t n) { return workloads.uniform(n, minVal, maxVal); });
     }
 
     std::vector<int> getPartOfArray(const std::vector<int>& array, int n) {
@@ -39,29 +42,16 @@ public:
         return newArray;
     }
 
-    std::vector<int> generateRandomArray() {
-        std::uniform_int_distribution<int> unif(0, 3000);
-        std::vector<int> array(6000);
-        for (int i = 0; i < 6000; ++i) {
-            array[i] = unif(randEngine);
-        }
-        return array;
+    std::vector<int> generateReversedArray(int size) {
+        return prefix("a2-reversed", size, [](const WorkloadGenerator& workloads, size_t n) {
+            return workloads.reversed(n, 0, 3000);
+        });
     }
 
-    std::vector<int> generateReversedArray() {
-        std::vector<int> array = generateRandomArray();
-        std::sort(array.begin(), array.end());
-        std::reverse(array.begin(), array.end());
-        return array;
-    }
-
-    std::vector<int> generateAlmostSortedArray() {
-        std::vector<int> array = generateRandomArray();
-        std::sort(array.begin(), array.end());
-        for (int i = 0; i < 6000; i += 20) {
-            std::swap(array[i], array[i + 1]);
-        }
-        return array;
+    std::vector<int> generateAlmostSortedArray(int size) {
+        return prefix("a2-almost-sorted", size, [](const WorkloadGenerator& workloads, size_t n) {
+            return workloads.almostSorted(n, 0, 3000);
+        });
     }
 };
 
@@ -75,6 +65,9 @@ double measureTime(Func sortingFunc, std::vector<int>& array, int threshold) {
 
 class SortTester {
 public:
+    // Sweep cells write CSV rows (separator ';') to their own stream instead of std::cout.
+    explicit SortTester(std::ostream& out = std::cout, char separator = ' ') : out(out), separator(separator) {}
+
     void runTest(const std::vector<int>& sourceArray, int size, std::function<void(std::vector<int>&, int)> sortingFunc, int iterations, int threshold, const std::string& label) {
         double totalTime = 0.0;
         for (int i = 0; i < iterations; ++i) {
@@ -82,29 +75,38 @@ public:
             array = ArrayGenerator().getPartOfArray(array, size);
             totalTime += measureTime(sortingFunc, array, threshold);
         }
-        std::cout << label << " " << size << " " << threshold << " " << (totalTime / iterations) << std::endl;
+        out << label << separator << size << separator << threshold << separator << (totalTime / iterations) << std::endl;
     }
 
     void testSort(const std::string& sortName, const std::function<void(std::vector<int>&, int)>& sortingFunc, ArrayGenerator& generator, int minSize, int maxSize, int step, int iterations, int threshold) {
         std::cout << "Testing " << sortName << "..." << std::endl;
 
         for (int size = minSize; size <= maxSize; size += step) {
-            auto randomArray = generator.generateRandomArray(size);
-            runTest(randomArray, size, sortingFunc, iterations, threshold, sortName + " Random");
+            testSize(sortName, sortingFunc, generator, size, iterations, threshold);
+        }
+    }
 
-            auto reversedArray = generator.generateReversedArray();
-            runTest(reversedArray, size, sortingFunc, iterations, threshold, sortName + " Reversed");
+    void testSize(const std::string& sortName, const std::function<void(std::vector<int>&, int)>& sortingFunc, ArrayGenerator& generator, int size, int iterations, int threshold) {
+        auto randomArray = generator.generateRandomArray(size);
+        runTest(randomArray, size, sortingFunc, iterations, threshold, sortName + separator + "Random");
 
-            auto almostSortedArray = generator.generateAlmostSortedArray();
-            runTest(almostSortedArray, size, sortingFunc, iterations, threshold, sortName + " AlmostSorted");
-        }
+        auto reversedArray = generator.generateReversedArray(size);
+        runTest(reversedArray, size, sortingFunc, iterations, threshold, sortName + separator + "Reversed");
+
+        auto almostSortedArray = generator.generateAlmostSortedArray(size);
+        runTest(almostSortedArray, size, sortingFunc, iterations, threshold, sortName + separator + "AlmostSorted");
     }
+
+private:
+    std::ostream& out;
+    char separator;
 };
 
-void merge(std::vector<int>& array, int left, int mid, int right) {
+template <typename T>
+void merge(std::vector<T>& array, int left, int mid, int right) {
     int n1 = mid - left + 1;
     int n2 = right - mid;
-    std::vector<int> L(n1), R(n2);
+    std::vector<T> L(n1), R(n2);
 
     for (int i = 0; i < n1; ++i) {
         L[i] = array[left + i];
@@ -129,7 +131,8 @@ void merge(std::vector<int>& array, int left, int mid, int right) {
     }
 }
 
-void mergeSort(std::vector<int>& array, int left, int right) {
+template <typename T>
+void mergeSort(std::vector<T>& array, int left, int right) {
     if (left < right) {
         int mid = left + (right - left) / 2;
         mergeSort(array, left, mid);
@@ -142,9 +145,10 @@ void mergeSortWrapper(std::vector<int>& array, int threshold = 0) {
     mergeSort(array, 0, array.size() - 1);
 }
 
-void insertionSort(std::vector<int>& array, int left, int right) {
+template <typename T>
+void insertionSort(std::vector<T>& array, int left, int right) {
     for (int i = left + 1; i <= right; ++i) {
-        int key = array[i];
+        T key = array[i];
         int j = i - 1;
         while (j >= left && array[j] > key) {
             array[j + 1] = array[j];
@@ -154,9 +158,15 @@ void insertionSort(std::vector<int>& array, int left, int right) {
     }
 }
 
-void hybridSort(std::vector<int>& array, int left, int right, int threshold) {
-    if (right - left + 1 <= threshold) {
-        insertionSort(array, left, right);
+template <typename T>
+void hybridSort(std::vector<T>& array, int left, int right, int threshold) {
+    int n = right - left + 1;
+    if (n <= threshold) {
+        if (n <= sorting_network::maxSize) {
+            sorting_network::sortSmall(array.data() + left, n);
+        } else {
+            insertionSort(array, left, right);
+        }
         return;
     }
 
@@ -172,12 +182,332 @@ void hybridSortWrapper(std::vector<int>& array, int threshold = 15) {
     hybridSort(array, 0, array.size() - 1, threshold);
 }
 
-int main() {
+// Argsort mode: sorts (key, index) pairs and returns the order for permuting records.
+std::vector<uint32_t> hybridArgsort(const std::vector<int>& keys, int threshold = 15) {
+    return argsort(keys, [threshold](std::vector<KeyIndex>& pairs) {
+        hybridSort(pairs, 0, static_cast<int>(pairs.size()) - 1, threshold);
+    });
+}
+
+void hybridArgsortWrapper(std::vector<int>& array, int threshold = 15) {
+    applyPermutation(array, hybridArgsort(array, threshold));
+}
+
+// Merges k sorted runs through a tournament tree that keeps the loser of every match, so
+// each output replays only the winner's leaf-to-root path: log k comparisons per element and
+// a single pass over memory. Nodes hold (key, exhausted, run) packed into one 64-bit word, so
+// a match is one unsigned comparison and the replay needs no branches or indirection. An
+// exhausted run is the maximum key with the exhausted bit set, a sentinel that loses to any
+// live element; equal keys come out in run order, so the merge is stable.
+template <typename T>
+class LoserTree {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 4, "keys are packed with their run index into 64 bits");
+
+public:
+    using Run = std::pair<const T*, const T*>;
+
+    explicit LoserTree(const std::vector<Run>& runs, bool gallop = true) : runs(runs), gallop(gallop) {
+        while (leaves < runs.size()) {
+            leaves <<= 1;
+        }
+        this->runs.resize(leaves, Run(nullptr, nullptr));
+        std::vector<uint64_t> heads(leaves);
+        for (size_t i = 0; i < leaves; ++i) {
+            heads[i] = next(i);
+        }
+        tree.assign(leaves, 0);
+        tree[0] = build(1, heads);
+    }
+
+    // Writes the next n elements to out.
+    void merge(T* out, size_t n) {
+        size_t written = 0;
+        size_t last = SIZE_MAX;
+        int streak = 0;
+        while (written < n) {
+            uint64_t w = tree[0];
+            size_t run = runOf(w);
+            streak = (streak + 1) & -static_cast<int>(run == last);
+            last = run;
+            if (gallop && streak >= minGallop) {
+                written += gallopRun(w, out + written, n - written);
+                streak = 0;
+            } else {
+                out[written++] = keyOf(w);
+            }
+            replay(run, next(run));
+        }
+    }
+
+private:
+    using Unsigned = std::make_unsigned_t<T>;
+
+    static constexpr int minGallop = 8;
+    static constexpr uint32_t signFlip = std::is_signed<T>::value ? 1u << (8 * sizeof(T) - 1) : 0;
+    static constexpr uint64_t exhaustedBit = 1ull << 31;
+
+    std::vector<Run> runs;
+    std::vector<uint64_t> tree;
+    size_t leaves = 1;
+    bool gallop;
+
+    static uint64_t pack(T key, size_t run) {
+        uint32_t ordered = static_cast<uint32_t>(static_cast<Unsigned>(key)) ^ signFlip;
+        return (static_cast<uint64_t>(ordered) << 32) | run;
+    }
+
+    static T keyOf(uint64_t packed) {
+        return static_cast<T>(static_cast<Unsigned>(static_cast<uint32_t>(packed >> 32) ^ signFlip));
+    }
+
+    static size_t runOf(uint64_t packed) {
+        return packed & (exhaustedBit - 1);
+    }
+
+    uint64_t next(size_t run) {
+        if (runs[run].first == runs[run].second) {
+            return pack(std::numeric_limits<T>::max(), run) | exhaustedBit;
+        }
+        return pack(*runs[run].first++, run);
+    }
+
+    uint64_t build(size_t node, const std::vector<uint64_t>& heads) {
+        if (node >= leaves) {
+            return heads[node - leaves];
+        }
+        uint64_t left = build(2 * node, heads);
+        uint64_t right = build(2 * node + 1, heads);
+        tree[node] = std::max(left, right);
+        return std::min(left, right);
+    }
+
+    // The exchange is done with a mask: which side wins is a coin flip on random input, and a
+    // branch here would mispredict at every level.
+    void replay(size_t run, uint64_t w) {
+        for (size_t node = (run + leaves) / 2; node >= 1; node /= 2) {
+            uint64_t other = tree[node];
+            uint64_t swap = (other ^ w) & (0 - static_cast<uint64_t>(other < w));
+            tree[node] = other ^ swap;
+            w ^= swap;
+        }
+        tree[0] = w;
+    }
+
+    // A run that keeps winning is copied in blocks: the strongest loser on the winner's path
+    // is the best of all other runs, and every element of the winning run that still beats it
+    // can go out without touching the tree. The block end is found by exponential search.
+    size_t gallopRun(uint64_t w, T* out, size_t limit) {
+        size_t run = runOf(w);
+        uint64_t rival = UINT64_MAX;
+        for (size_t node = (run + leaves) / 2; node >= 1; node /= 2) {
+            rival = std::min(rival, tree[node]);
+        }
+        auto beats = [&](const T& value) {
+            return pack(value, run) < rival;
+        };
+
+        out[0] = keyOf(w);
+        const T* first = runs[run].first;
+        size_t available = std::min<size_t>(runs[run].second - first, limit - 1);
+        size_t bound = 1;
+        while (bound < available && beats(first[bound - 1])) {
+            bound *= 2;
+        }
+        bound = std::min(bound, available);
+        size_t count = std::partition_point(first, first + bound, beats) - first;
+        std::copy(first, first + count, out + 1);
+        runs[run].first += count;
+        return count + 1;
+    }
+};
+
+// Cuts every run so that the left parts together hold the rank smallest elements, with equal
+// keys taken from lower-numbered runs first as the merge does. Binary search over the value
+// range, so integer keys only.
+template <typename T>
+std::vector<size_t> multiwaySplit(const std::vector<std::pair<const T*, const T*>>& runs, size_t rank) {
+    using Unsigned = std::make_unsigned_t<T>;
+    std::vector<size_t> splits(runs.size(), 0);
+    bool any = false;
+    T lo = std::numeric_limits<T>::max(), hi = std::numeric_limits<T>::min();
+    for (const auto& run : runs) {
+        if (run.first != run.second) {
+            lo = std::min(lo, *run.first);
+            hi = std::max(hi, *(run.second - 1));
+            any = true;
+        }
+    }
+    if (rank == 0 || !any) {
+        return splits;
+    }
+    auto countAtMost = [&](T value) {
+        size_t count = 0;
+        for (const auto& run : runs) {
+            count += std::upper_bound(run.first, run.second, value) - run.first;
+        }
+        return count;
+    };
+    while (lo < hi) {
+        T mid = static_cast<T>(lo + static_cast<T>((static_cast<Unsigned>(hi) - static_cast<Unsigned>(lo)) / 2));
+        if (countAtMost(mid) >= rank) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    size_t taken = 0;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        splits[i] = std::lower_bound(runs[i].first, runs[i].second, lo) - runs[i].first;
+        taken += splits[i];
+    }
+    for (size_t i = 0; i < runs.size() && taken < rank; ++i) {
+        size_t equal = std::upper_bound(runs[i].first, runs[i].second, lo) - runs[i].first - splits[i];
+        size_t take = std::min(equal, rank - taken);
+        splits[i] += take;
+        taken += take;
+    }
+    return splits;
+}
+
+// k-way merge of sorted runs into out. With several threads the output is cut into equal
+// ranges by multiway selection and each thread merges its own slice of every run.
+template <typename T>
+void multiwayMerge(const std::vector<std::pair<const T*, const T*>>& runs, T* out, unsigned threads = 1, bool gallop = true) {
+    size_t total = 0;
+    for (const auto& run : runs) {
+        total += run.second - run.first;
+    }
+    size_t parts = std::max<size_t>(1, std::min<size_t>(threads, total / 65536));
+    if (parts == 1) {
+        LoserTree<T>(runs, gallop).merge(out, total);
+        return;
+    }
+
+    std::vector<std::vector<size_t>> splits(parts + 1);
+    splits[0].assign(runs.size(), 0);
+    for (size_t p = 1; p < parts; ++p) {
+        splits[p] = multiwaySplit(runs, total * p / parts);
+    }
+    for (const auto& run : runs) {
+        splits[parts].push_back(run.second - run.first);
+    }
+
+    std::vector<std::thread> pool;
+    for (size_t p = 0; p < parts; ++p) {
+        pool.emplace_back([&, p] {
+            std::vector<std::pair<const T*, const T*>> slice(runs.size());
+            for (size_t i = 0; i < runs.size(); ++i) {
+                slice[i] = {runs[i].first + splits[p][i], runs[i].first + splits[p + 1][i]};
+            }
+            LoserTree<T>(slice, gallop).merge(out + total * p / parts, total * (p + 1) / parts - total * p / parts);
+        });
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+template <typename T>
+std::vector<T> multiwayMerge(const std::vector<std::vector<T>>& shards, unsigned threads = 1, bool gallop = true) {
+    std::vector<std::pair<const T*, const T*>> runs;
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        runs.emplace_back(shard.data(), shard.data() + shard.size());
+        total += shard.size();
+    }
+    std::vector<T> out(total);
+    multiwayMerge(runs, out.data(), threads, gallop);
+    return out;
+}
+
+// Merges k sorted shards of one array: log k pairwise merge() passes against a single
+// loser-tree pass, sequential and threaded. The shard count goes in the threshold column.
+void testMultiwayMerge(ArrayGenerator& generator, int size, const std::vector<int>& shardCounts, int iterations, unsigned threads) {
+    std::cout << "Testing MultiwayMerge..." << std::endl;
+    std::vector<int> source = generator.generateRandomArray(size, 0, 1 << 30);
+
+    for (int k : shardCounts) {
+        std::vector<int> bounds(k + 1);
+        for (int i = 0; i <= k; ++i) {
+            bounds[i] = static_cast<int>(static_cast<long long>(size) * i / k);
+        }
+        std::vector<int> shards = source;
+        std::vector<std::pair<const int*, const int*>> runs;
+        for (int i = 0; i < k; ++i) {
+            std::sort(shards.begin() + bounds[i], shards.begin() + bounds[i + 1]);
+            runs.emplace_back(shards.data() + bounds[i], shards.data() + bounds[i + 1]);
+        }
+
+        double pairwiseTime = 0, treeTime = 0, parallelTime = 0;
+        for (int it = 0; it < iterations; ++it) {
+            std::vector<int> array = shards;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int width = 1; width < k; width *= 2) {
+                for (int i = 0; i + width < k; i += 2 * width) {
+                    merge(array, bounds[i], bounds[i + width] - 1, bounds[std::min(i + 2 * width, k)] - 1);
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            pairwiseTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+            std::vector<int> out(size);
+            start = std::chrono::high_resolution_clock::now();
+            multiwayMerge(runs, out.data(), 1);
+            end = std::chrono::high_resolution_clock::now();
+            treeTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+            start = std::chrono::high_resolution_clock::now();
+            multiwayMerge(runs, out.data(), threads);
+            end = std::chrono::high_resolution_clock::now();
+            parallelTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        }
+        std::cout << "Pairwise " << size << " " << k << " " << (pairwiseTime / iterations) << std::endl;
+        std::cout << "LoserTree " << size << " " << k << " " << (treeTime / iterations) << std::endl;
+        std::cout << "LoserTreeParallel " << size << " " << k << " " << (parallelTime / iterations) << std::endl;
+    }
+}
+
+// The testSort grid as sweep cells, one per (algorithm, threshold, size), written as
+// data_a2.csv rows. Each cell has its own generator; the datasets it maps are shared on disk.
+void runSweep(const std::string& journalPath, const std::string& outputPath, int minSize, int maxSize, int step, int iterations) {
+    std::vector<std::tuple<std::string, std::function<void(std::vector<int>&, int)>, int>> configurations = {
+        {"Merge", mergeSortWrapper, 0},   {"Hybrid", hybridSortWrapper, 5},  {"Hybrid", hybridSortWrapper, 10},
+        {"Hybrid", hybridSortWrapper, 20}, {"Hybrid", hybridSortWrapper, 30}, {"Hybrid", hybridSortWrapper, 50},
+        {"HybridArgsort", hybridArgsortWrapper, 15},
+    };
+    // Materialize the cached datasets up front so that cells only ever map them.
+    ArrayGenerator().generateRandomArray(maxSize);
+    ArrayGenerator().generateReversedArray(maxSize);
+    ArrayGenerator().generateAlmostSortedArray(maxSize);
+
+    SweepRunner runner(journalPath);
+    for (const auto& [sortName, sortingFunc, threshold] : configurations) {
+        for (int size = minSize; size <= maxSize; size += step) {
+            std::string key = sortName + " " + std::to_string(threshold) + " " + std::to_string(size);
+            runner.add(key, [=, sortName = sortName, sortingFunc = sortingFunc, threshold = threshold](SweepRunner::Output& out) {
+                ArrayGenerator generator;
+                SortTester(out[0], ';').testSize(sortName, sortingFunc, generator, size, iterations, threshold);
+            });
+        }
+    }
+    std::ofstream output(outputPath);
+    runner.run({&output});
+    std::cout << "Sweep: " << runner.ran() << " cells run, " << runner.reused() << " reused from " << journalPath << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     ArrayGenerator generator;
     SortTester tester;
 
     int minSize = 500, maxSize = 10000, step = 100, iterations = 5, threshold = 0;
 
+    // ./a2 sweep [journal] [output csv]
+    if (argc > 1 && std::string(argv[1]) == "sweep") {
+        runSweep(argc > 2 ? argv[2] : "a2-sweep.journal", argc > 3 ? argv[3] : "sweep_a2.csv", minSize, maxSize, step, iterations);
+        return 0;
+    }
+
     tester.testSort("Merge", mergeSortWrapper, generator, minSize, maxSize, step, iterations, threshold);
     
     threshold = 5;
@@ -195,6 +525,11 @@ int main() {
     threshold = 50;
     tester.testSort("Hybrid", hybridSortWrapper, generator, minSize, maxSize, step, iterations, threshold);
 
+    threshold = 15;
+    tester.testSort("HybridArgsort", hybridArgsortWrapper, generator, minSize, maxSize, step, iterations, threshold);
+
+    testMultiwayMerge(generator, 1 << 22, {2, 4, 16, 64}, iterations, std::thread::hardware_concurrency());
+
     return 0;
 }
 
@@ -5,39 +5,40 @@
 #include <chrono>
 #include <functional>
 
+#include "../../common/argsort.h"
+#include "../../common/datasetCache.h"
+#include "../../common/sortingNetworks.h"
+#include "../../common/vectorSort.h"
+#include "../../common/workloadGenerator.h"
+
 class ArrayGenerator {
 private:
-    std::mt19937 randEngine;
+    DatasetCache datasets;
+    const int maxSize = 10000;
 
-public:
-    ArrayGenerator() {
-        std::random_device randDevice;
-        randEngine = std::mt19937(randDevice());
+    // Every distribution is generated once at maxSize (or the largest size asked for) and
+    // cached on disk; shorter arrays are its prefixes.
+    std::vector<int> prefix(const std::string& name, int size, const DatasetCache::Maker<int>& make) {
+        const MappedDataset& dataset = datasets.ints(name, std::max(size, maxSize), make);
+        return std::vector<int>(dataset.ints(), dataset.ints() + size);
     }
 
+public:
     std::vector<int> generateRandomArray(int size, int minVal = 0, int maxVal = 6000) {
-        std::uniform_int_distribution<int> unif(minVal, maxVal);
-        std::vector<int> array(size);
-        for (int i = 0; i < size; ++i) {
-            array[i] = unif(randEngine);
-        }
-        return array;
+        return prefix("a3-random-" + std::to_string(minVal) + "-" + std::to_string(maxVal), size,
+                      [=](const WorkloadGenerator& workloads, size_t n) { return workloads.uniform(n, minVal, maxVal); });
     }
 
     std::vector<int> generateReversedArray(int size) {
-        std::vector<int> array = generateRandomArray(size);
-        std::sort(array.begin(), array.end());
-        std::reverse(array.begin(), array.end());
-        return array;
+        return prefix("a3-reversed", size, [](const WorkloadGenerator& workloads, size_t n) {
+            return workloads.reversed(n, 0, 6000);
+        });
     }
 
     std::vector<int> generateAlmostSortedArray(int size) {
-        std::vector<int> array = generateRandomArray(size);
-        std::sort(array.begin(), array.end());
-        for (int i = 0; i < size; i += 20) {
-            std::swap(array[i], array[i + 1]);
-        }
-        return array;
+        return prefix("a3-almost-sorted", size, [](const WorkloadGenerator& workloads, size_t n) {
+            return workloads.almostSorted(n, 0, 6000);
+        });
     }
 };
 
@@ -75,20 +76,45 @@ public:
             runTest(almostSortedArray, size, sortingFunc, iterations, sortName + " AlmostSorted");
         }
     }
-};
 
-void quickSort(std::vector<int>& array, int low, int high) {
-    if (low < high) {
-        int pivot = array[high];
-        int i = low - 1;
-        for (int j = low; j < high; ++j) {
-            if (array[j] <= pivot) {
-                ++i;
-                std::swap(array[i], array[j]);
+    void testWorkloads(const std::string& sortName, const std::function<void(std::vector<int>&)>& sortingFunc, const WorkloadGenerator& workloads, int minSize, int maxSize, int step, int iterations) {
+        std::cout << "Testing " << sortName << " on workloads..." << std::endl;
+
+        for (int size = minSize; size <= maxSize; size += step) {
+            std::vector<std::pair<std::string, std::vector<int>>> sources = {
+                {"Zipf", workloads.zipf(size, size)},
+                {"Normal", workloads.normal(size, 3000, 500)},
+                {"DuplicateHeavy", workloads.duplicateHeavy(size)},
+                {"FewUnique", workloads.fewUnique(size)},
+                {"Sawtooth", workloads.sawtooth(size, 100)},
+                {"OrganPipe", workloads.organPipe(size)},
+                {"SortedWithInserts", workloads.sortedWithRandomInserts(size, size / 100)},
+            };
+            for (const auto& [name, source] : sources) {
+                runTest(source, size, sortingFunc, iterations, sortName + " " + name);
             }
         }
-        std::swap(array[i + 1], array[high]);
-        int pivotIndex = i + 1;
+    }
+};
+
+template <typename T>
+int partition(std::vector<T>& array, int low, int high) {
+    T pivot = array[high];
+    int i = low - 1;
+    for (int j = low; j < high; ++j) {
+        if (array[j] <= pivot) {
+            ++i;
+            std::swap(array[i], array[j]);
+        }
+    }
+    std::swap(array[i + 1], array[high]);
+    return i + 1;
+}
+
+template <typename T>
+void quickSort(std::vector<T>& array, int low, int high) {
+    if (low < high) {
+        int pivotIndex = partition(array, low, high);
 
         quickSort(array, low, pivotIndex - 1);
         quickSort(array, pivotIndex + 1, high);
@@ -99,39 +125,236 @@ void quickSortWrapper(std::vector<int>& array) {
     quickSort(array, 0, array.size() - 1);
 }
 
-void heapify(std::vector<int>& array, int n, int i) {
-    int largest = i;
-    int left = 2 * i + 1;
-    int right = 2 * i + 2;
+// d-ary max-heap kernels. With Arity 4 or 8 the children of a node are adjacent ints, so
+// picking the largest child touches one cache line instead of one line per tree level.
+// Values move into a hole rather than being swapped down.
+constexpr int HeapArity = 4;
+
+template <int Arity, typename T, typename Less>
+int largestChild(const T* heap, int n, int i, Less less) {
+    int first = Arity * i + 1;
+    int last = std::min(first + Arity, n);
+    int best = first;
+    for (int c = first + 1; c < last; ++c) {
+        if (less(heap[best], heap[c])) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+template <int Arity, typename T, typename Less>
+void siftDown(T* heap, int n, int i, Less less) {
+    T value = std::move(heap[i]);
+    while (Arity * i + 1 < n) {
+        int best = largestChild<Arity>(heap, n, i, less);
+        if (!less(value, heap[best])) {
+            break;
+        }
+        heap[i] = std::move(heap[best]);
+        i = best;
+    }
+    heap[i] = std::move(value);
+}
+
+template <int Arity, typename T, typename Less>
+void siftUp(T* heap, int i, Less less) {
+    T value = std::move(heap[i]);
+    while (i > 0) {
+        int parent = (i - 1) / Arity;
+        if (!less(heap[parent], value)) {
+            break;
+        }
+        heap[i] = std::move(heap[parent]);
+        i = parent;
+    }
+    heap[i] = std::move(value);
+}
+
+// Floyd's construction: sift down every internal node, last one first, in O(n).
+template <int Arity, typename T, typename Less>
+void buildHeap(T* heap, int n, Less less) {
+    for (int i = (n - 2) / Arity; i >= 0 && n > 1; --i) {
+        siftDown<Arity>(heap, n, i, less);
+    }
+}
+
+// Moves the maximum to heap[n - 1]. The hole left at the root is walked down to a leaf
+// along the largest children without comparing against the displaced last element, which
+// then only has to climb back a level or two (bottom-up heapsort).
+template <int Arity, typename T, typename Less>
+void popHeap(T* heap, int n, Less less) {
+    if (n <= 1) {
+        return;
+    }
+    T value = std::move(heap[n - 1]);
+    heap[n - 1] = std::move(heap[0]);
+    int size = n - 1;
+    int i = 0;
+    while (Arity * i + 1 < size) {
+        int best = largestChild<Arity>(heap, size, i, less);
+        heap[i] = std::move(heap[best]);
+        i = best;
+    }
+    heap[i] = std::move(value);
+    siftUp<Arity>(heap, i, less);
+}
+
+template <typename T, int Arity = HeapArity, typename Less = std::less<T>>
+class PriorityQueue {
+public:
+    explicit PriorityQueue(Less less = Less()) : less(less) {}
+
+    void push(T value) {
+        heap.push_back(std::move(value));
+        siftUp<Arity>(heap.data(), heap.size() - 1, less);
+    }
+
+    const T& top() const {
+        return heap.front();
+    }
+
+    T pop() {
+        popHeap<Arity>(heap.data(), heap.size(), less);
+        T value = std::move(heap.back());
+        heap.pop_back();
+        return value;
+    }
 
-    if (left < n && array[left] > array[largest]) {
-        largest = left;
+    // Replaces the top element; cheaper than pop() followed by push().
+    void replaceTop(T value) {
+        heap.front() = std::move(value);
+        siftDown<Arity>(heap.data(), heap.size(), 0, less);
     }
-    if (right < n && array[right] > array[largest]) {
-        largest = right;
+
+    [[nodiscard]] size_t size() const {
+        return heap.size();
     }
 
-    if (largest != i) {
-        std::swap(array[i], array[largest]);
-        heapify(array, n, largest);
+    [[nodiscard]] bool empty() const {
+        return heap.empty();
     }
+
+private:
+    std::vector<T> heap;
+    Less less;
+};
+
+void heapify(std::vector<int>& array, int n, int i, int offset = 0) {
+    siftDown<HeapArity>(array.data() + offset, n, i, std::less<int>());
+}
+
+template <typename T>
+void heapSort(std::vector<T>& array, int low, int high) {
+    int n = high - low + 1;
+    buildHeap<HeapArity>(array.data() + low, n, std::less<T>());
+    for (int i = n; i > 1; --i) {
+        popHeap<HeapArity>(array.data() + low, i, std::less<T>());
+    }
+}
+
+template <typename T>
+void heapSort(std::vector<T>& array) {
+    heapSort(array, 0, static_cast<int>(array.size()) - 1);
 }
 
-void heapSort(std::vector<int>& array) {
+// Introselect: places the k-th smallest element at array[k], smaller ones before it and
+// larger ones after. Median-of-three Lomuto partitioning gives expected O(n); past the
+// depth limit the remaining range is heap-sorted, bounding the worst case at O(n log n).
+void nthElement(std::vector<int>& array, int k) {
+    int low = 0;
+    int high = static_cast<int>(array.size()) - 1;
+    if (k < low || k > high) {
+        return;
+    }
+    int depthLimit = 2 * log(array.size()) / log(2);
+    while (low < high) {
+        if (depthLimit-- == 0) {
+            heapSort(array, low, high);
+            return;
+        }
+        int mid = low + (high - low) / 2;
+        if (array[mid] < array[low]) {
+            std::swap(array[mid], array[low]);
+        }
+        if (array[high] < array[low]) {
+            std::swap(array[high], array[low]);
+        }
+        if (array[mid] < array[high]) {
+            std::swap(array[mid], array[high]);
+        }
+        int pivotIndex = partition(array, low, high);
+        if (k == pivotIndex) {
+            return;
+        }
+        if (k < pivotIndex) {
+            high = pivotIndex - 1;
+        } else {
+            low = pivotIndex + 1;
+        }
+    }
+}
+
+// Sorts the k smallest elements into array[0..k) using a max-heap of the k best seen so far.
+void partialSort(std::vector<int>& array, int k) {
     int n = array.size();
-    for (int i = n / 2 - 1; i >= 0; --i) {
-        heapify(array, n, i);
+    k = std::min(k, n);
+    if (k <= 0) {
+        return;
+    }
+    buildHeap<HeapArity>(array.data(), k, std::less<int>());
+    for (int i = k; i < n; ++i) {
+        if (array[i] < array[0]) {
+            std::swap(array[0], array[i]);
+            heapify(array, k, 0);
+        }
     }
-    for (int i = n - 1; i >= 0; --i) {
-        std::swap(array[0], array[i]);
-        heapify(array, i, 0);
+    for (int i = k; i > 1; --i) {
+        popHeap<HeapArity>(array.data(), i, std::less<int>());
     }
 }
 
-void insertionSort(std::vector<int>& array) {
+// Keeps the k smallest values of a stream that arrives in chunks, in O(k) memory.
+class StreamingTopK {
+public:
+    explicit StreamingTopK(int k) : k(std::max(k, 0)) {
+        heap.reserve(this->k);
+    }
+
+    void push(const int* data, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (static_cast<int>(heap.size()) < k) {
+                heap.push_back(data[i]);
+                if (static_cast<int>(heap.size()) == k) {
+                    buildHeap<HeapArity>(heap.data(), k, std::less<int>());
+                }
+            } else if (k > 0 && data[i] < heap[0]) {
+                heap[0] = data[i];
+                heapify(heap, k, 0);
+            }
+        }
+    }
+
+    void push(const std::vector<int>& chunk) {
+        push(chunk.data(), chunk.size());
+    }
+
+    std::vector<int> result() const {
+        std::vector<int> sorted = heap;
+        heapSort(sorted);
+        return sorted;
+    }
+
+private:
+    int k;
+    std::vector<int> heap;
+};
+
+template <typename T>
+void insertionSort(std::vector<T>& array) {
     int n = array.size();
     for (int i = 1; i < n; ++i) {
-        int key = array[i];
+        T key = array[i];
         int j = i - 1;
         while (j >= 0 && array[j] > key) {
             array[j + 1] = array[j];
@@ -141,10 +364,28 @@ void insertionSort(std::vector<int>& array) {
     }
 }
 
-void introsort(std::vector<int>& array, int depthLimit) {
+// Splits array around pivot into left (smaller) and right (larger) and returns how many
+// elements equal it.
+template <typename T>
+int threeWaySplit(const std::vector<T>& array, const T& pivot, std::vector<T>& left, std::vector<T>& right) {
+    int equal = 0;
+    for (const T& value : array) {
+        if (value < pivot) {
+            left.push_back(value);
+        } else if (pivot < value) {
+            right.push_back(value);
+        } else {
+            ++equal;
+        }
+    }
+    return equal;
+}
+
+template <typename T>
+void introsort(std::vector<T>& array, int depthLimit) {
     int n = array.size();
     if (n <= 16) {
-        insertionSort(array);
+        sorting_network::sortSmall(array.data(), n);
         return;
     }
 
@@ -153,22 +394,16 @@ void introsort(std::vector<int>& array, int depthLimit) {
         return;
     }
 
-    int pivot = array[n / 2];
-    std::vector<int> left, right;
-    for (int i = 0; i < n; ++i) {
-        if (array[i] < pivot) {
-            left.push_back(array[i]);
-        } else if (array[i] > pivot) {
-            right.push_back(array[i]);
-        }
-    }
+    T pivot = array[n / 2];
+    std::vector<T> left, right;
+    int equal = threeWaySplit(array, pivot, left, right);
 
     introsort(left, depthLimit - 1);
     introsort(right, depthLimit - 1);
 
     array.clear();
     array.insert(array.end(), left.begin(), left.end());
-    array.push_back(pivot);
+    array.insert(array.end(), equal, pivot);
     array.insert(array.end(), right.begin(), right.end());
 }
 
@@ -177,6 +412,94 @@ void introsortWrapper(std::vector<int>& array) {
     introsort(array, depthLimit);
 }
 
+template <typename T>
+void appendRuns(const std::vector<T>& sorted, std::vector<std::pair<T, uint32_t>>& groups) {
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i + 1;
+        while (j < sorted.size() && !(sorted[i] < sorted[j])) {
+            ++j;
+        }
+        groups.push_back({sorted[i], static_cast<uint32_t>(j - i)});
+        i = j;
+    }
+}
+
+// Distinct mode: appends each key once with its multiplicity, in ascending order. The equal
+// partition of every step is a finished group, so duplicate-heavy inputs stop recursing early;
+// only the small and depth-limited leaves collapse runs after sorting.
+template <typename T>
+void introsortDistinct(std::vector<T>& array, int depthLimit, std::vector<std::pair<T, uint32_t>>& groups) {
+    int n = array.size();
+    if (n <= 16 || depthLimit == 0) {
+        if (n <= 16) {
+            sorting_network::sortSmall(array.data(), n);
+        } else {
+            heapSort(array);
+        }
+        appendRuns(array, groups);
+        return;
+    }
+
+    T pivot = array[n / 2];
+    std::vector<T> left, right;
+    int equal = threeWaySplit(array, pivot, left, right);
+
+    introsortDistinct(left, depthLimit - 1, groups);
+    groups.push_back({pivot, static_cast<uint32_t>(equal)});
+    introsortDistinct(right, depthLimit - 1, groups);
+}
+
+std::vector<std::pair<int, uint32_t>> introsortDistinct(std::vector<int> array) {
+    std::vector<std::pair<int, uint32_t>> groups;
+    introsortDistinct(array, 2 * log(std::max<size_t>(array.size(), 1)) / log(2), groups);
+    return groups;
+}
+
+// Leaves the distinct keys in array; the tester only times the call.
+void introsortDistinctWrapper(std::vector<int>& array) {
+    std::vector<std::pair<int, uint32_t>> groups = introsortDistinct(std::move(array));
+    array.resize(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        array[i] = groups[i].first;
+    }
+}
+
+// Argsort mode: sorts (key, index) pairs and returns the order for permuting records.
+std::vector<uint32_t> introsortArgsort(const std::vector<int>& keys) {
+    return argsort(keys, [](std::vector<KeyIndex>& pairs) {
+        introsort(pairs, 2 * log(std::max<size_t>(pairs.size(), 1)) / log(2));
+    });
+}
+
+void introsortArgsortWrapper(std::vector<int>& array) {
+    applyPermutation(array, introsortArgsort(array));
+}
+
+void stdSortWrapper(std::vector<int>& array) {
+    std::sort(array.begin(), array.end());
+}
+
+void vectorSortWrapper(std::vector<int>& array) {
+    vector_sort::sort(array.data(), array.size());
+}
+
+void medianWrapper(std::vector<int>& array) {
+    nthElement(array, array.size() / 2);
+}
+
+void partialSortWrapper(std::vector<int>& array) {
+    partialSort(array, 100);
+}
+
+void streamingTopKWrapper(std::vector<int>& array) {
+    StreamingTopK topK(100);
+    for (size_t start = 0; start < array.size(); start += 1000) {
+        topK.push(array.data() + start, std::min<size_t>(1000, array.size() - start));
+    }
+    std::vector<int> smallest = topK.result();
+    std::copy(smallest.begin(), smallest.end(), array.begin());
+}
+
 int main() {
     ArrayGenerator generator;
     SortTester tester;
@@ -185,5 +508,20 @@ int main() {
 
     tester.testSort("QuickSort", quickSortWrapper, generator, minSize, maxSize, step, iterations);
     tester.testSort("Introsort", introsortWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("IntrosortArgsort", introsortArgsortWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("IntrosortDistinct", introsortDistinctWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("StdSort", stdSortWrapper, generator, minSize, maxSize, step, iterations);
+    std::cout << "VectorSort uses " << vector_sort::isaName(vector_sort::bestIsa()) << std::endl;
+    tester.testSort("VectorSort", vectorSortWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("NthElement", medianWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("PartialSort", partialSortWrapper, generator, minSize, maxSize, step, iterations);
+    tester.testSort("StreamingTopK", streamingTopKWrapper, generator, minSize, maxSize, step, iterations);
+
+    WorkloadGenerator workloads;
+    tester.testWorkloads("QuickSort", quickSortWrapper, workloads, minSize, maxSize, step, iterations);
+    tester.testWorkloads("Introsort", introsortWrapper, workloads, minSize, maxSize, step, iterations);
+    tester.testWorkloads("IntrosortDistinct", introsortDistinctWrapper, workloads, minSize, maxSize, step, iterations);
+    tester.testWorkloads("StdSort", stdSortWrapper, workloads, minSize, maxSize, step, iterations);
+    tester.testWorkloads("VectorSort", vectorSortWrapper, workloads, minSize, maxSize, step, iterations);
     return 0;
 }
@@ -4,7 +4,208 @@
 #include <chrono>
 #include <numeric>
 #include <fstream>
+#include <sstream>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <limits>
+#include <cmath>
+#include <sys/resource.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
+#include "../common/workloadGenerator.h"
+#include "../common/sweepRunner.h"
+
+struct ModuloHash {
+    size_t M;
+
+    explicit ModuloHash(size_t size) : M(size) {}
+
+    static size_t table_size(size_t requested) {
+        return std::max<size_t>(requested, 1);
+    }
+
+    size_t operator()(uint64_t key) const {
+        return key % M;
+    }
+};
+
+// Multiplicative hashing by 2^64 / phi; keeps the top bits, so the table size is a power of two.
+struct FibonacciHash {
+    unsigned shift;
+
+    explicit FibonacciHash(size_t size) : shift(64 - __builtin_ctzll(size)) {}
+
+    static size_t table_size(size_t requested) {
+        size_t size = 2;
+        while (size < requested) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    size_t operator()(uint64_t key) const {
+        return (key * 0x9E3779B97F4A7C15ull) >> shift;
+    }
+};
+
+struct MurmurMix {
+    static uint64_t mix(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        key *= 0xC4CEB9FE1A85EC53ull;
+        key ^= key >> 33;
+        return key;
+    }
+};
+
+struct WyMix {
+    static uint64_t mix(uint64_t key) {
+        unsigned __int128 product = static_cast<unsigned __int128>(key ^ 0xA0761D6478BD642Full) * 0xE7037ED1A0B428DBull;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+};
+
+// Lemire's fast range: maps a well-mixed 64-bit hash onto [0, M) with one multiply, any M.
+template <typename Mixer>
+struct FastRangeHash {
+    size_t M;
+
+    explicit FastRangeHash(size_t size) : M(size) {}
+
+    static size_t table_size(size_t requested) {
+        return std::max<size_t>(requested, 1);
+    }
+
+    size_t operator()(uint64_t key) const {
+        return static_cast<size_t>((static_cast<unsigned __int128>(Mixer::mix(key)) * M) >> 64);
+    }
+};
+
+using DefaultHashPolicy = FastRangeHash<MurmurMix>;
+
+// Tables that grow on insert need a load factor in (0, 1): at 0 or below every insert
+// rehashes again, at 1 or above the table can fill up and a probe for a free slot never
+// ends. NaN falls to the lower bound.
+inline double clamp_load_factor(double max_load_factor) {
+    return max_load_factor > 0.1 ? std::min(max_load_factor, 0.99) : 0.1;
+}
+
+// Probe cursors walk (home + offset(i)) mod M by finite differences, so each step is a few
+// additions with a conditional subtraction instead of a division.
+inline size_t add_mod(size_t a, size_t b, size_t M) {
+    size_t sum = a + b;
+    return sum >= M ? sum - M : sum;
+}
+
+struct LinearProbe {
+    static constexpr bool early_exit = false;
+
+    static size_t offset(size_t i) {
+        return i;
+    }
+
+    class Cursor {
+    public:
+        Cursor(size_t home, size_t M) : index(home), M(M) {}
+
+        size_t operator*() const {
+            return index;
+        }
+
+        void next() {
+            index = index + 1 == M ? 0 : index + 1;
+        }
+
+    private:
+        size_t index, M;
+    };
+};
+
+// Same sequence as linear probing, but the table is kept ordered by displacement,
+// so a lookup can stop at the first resident that sits closer to its home slot.
+struct RobinHoodProbe : LinearProbe {
+    static constexpr bool early_exit = true;
+};
+
+struct QuadraticProbe {
+    static constexpr bool early_exit = false;
+
+    static size_t offset(size_t i) {
+        return i + i * i;
+    }
+
+    class Cursor {
+    public:
+        Cursor(size_t home, size_t M) : index(home), delta(2 % M), step(2 % M), M(M) {}
+
+        size_t operator*() const {
+            return index;
+        }
+
+        void next() {
+            index = add_mod(index, delta, M);
+            delta = add_mod(delta, step, M);
+        }
+
+    private:
+        size_t index, delta, step, M;
+    };
+};
+
+struct CubicProbe {
+    static constexpr bool early_exit = false;
+
+    static size_t offset(size_t i) {
+        return i + i * i + i * i * i;
+    }
+
+    class Cursor {
+    public:
+        Cursor(size_t home, size_t M) : index(home), delta(3 % M), second(8 % M), third(6 % M), M(M) {}
+
+        size_t operator*() const {
+            return index;
+        }
+
+        void next() {
+            index = add_mod(index, delta, M);
+            delta = add_mod(delta, second, M);
+            second = add_mod(second, third, M);
+        }
+
+    private:
+        size_t index, delta, second, third, M;
+    };
+};
+
+struct ProbeStats {
+    std::vector<size_t> histogram;
+    size_t maxPSL = 0;
+    double avgSuccessful = 0;
+    double avgUnsuccessful = 0;
+
+    [[nodiscard]] size_t percentile(double q) const {
+        size_t total = std::accumulate(histogram.begin(), histogram.end(), size_t(0));
+        size_t seen = 0;
+        for (size_t psl = 0; psl < histogram.size(); ++psl) {
+            seen += histogram[psl];
+            if (seen >= q * total) {
+                return psl;
+            }
+        }
+        return maxPSL;
+    }
+};
+
+template <typename HashPolicy = DefaultHashPolicy>
 class HashTable {
 private:
     struct Value {
@@ -15,50 +216,137 @@ private:
     };
 
     size_t M;
+    HashPolicy policy;
     std::vector<Value> table;
-    int collisions = 0;  
+    size_t filled = 0;
+    uint64_t collisions = 0;
 
     [[nodiscard]] size_t get_hash(int key) const {
-        return key % M;
+        return policy(static_cast<uint64_t>(key));
     }
 
-public:
-    explicit HashTable(size_t size) : M(size), table(size) {}
+    [[nodiscard]] size_t distance(size_t index) const {
+        size_t home = get_hash(table[index].key);
+        return index >= home ? index - home : index + M - home;
+    }
 
-    bool quadratic_insert(int key) {
-        size_t hash = get_hash(key);
-        for (size_t i = 0; i < M; ++i) {
-            size_t index = (hash + i + i * i) % M;
+    template <typename Probe>
+    bool probe_insert(int key) {
+        typename Probe::Cursor probe(get_hash(key), M);
+        for (size_t i = 0; i < M; ++i, probe.next()) {
+            size_t index = *probe;
             if (table[index].hasValue && table[index].key == key) {
                 return true;
             }
             if (!table[index].hasValue) {
                 table[index] = Value(key);
+                filled++;
                 return true;
             }
-            collisions++;  
+            collisions++;
         }
         return false;
     }
 
+public:
+    explicit HashTable(size_t size) : M(HashPolicy::table_size(size)), policy(M), table(M) {}
+
+    bool linear_insert(int key) {
+        return probe_insert<LinearProbe>(key);
+    }
+
+    bool quadratic_insert(int key) {
+        return probe_insert<QuadraticProbe>(key);
+    }
+
     bool cubic_insert(int key) {
-        size_t hash = get_hash(key);
+        return probe_insert<CubicProbe>(key);
+    }
+
+    bool robin_hood_insert(int key) {
+        if (filled == M) {
+            return contains<RobinHoodProbe>(key);
+        }
+        size_t index = get_hash(key);
+        size_t dist = 0;
         for (size_t i = 0; i < M; ++i) {
-            size_t index = (hash + i + i * i + i * i * i) % M;
-            if (table[index].hasValue && table[index].key == key) {
-                return true;
-            }
             if (!table[index].hasValue) {
                 table[index] = Value(key);
+                filled++;
+                return true;
+            }
+            if (table[index].key == key) {
+                return true;
+            }
+            size_t residentDist = distance(index);
+            if (residentDist < dist) {
+                std::swap(key, table[index].key);
+                dist = residentDist;
+            }
+            collisions++;
+            dist++;
+            index = index + 1 == M ? 0 : index + 1;
+        }
+        return false;
+    }
+
+    template <typename Probe>
+    bool contains(int key) const {
+        typename Probe::Cursor probe(get_hash(key), M);
+        for (size_t i = 0; i < M; ++i, probe.next()) {
+            const Value& cell = table[*probe];
+            if (!cell.hasValue || (Probe::early_exit && distance(*probe) < i)) {
+                return false;
+            }
+            if (cell.key == key) {
                 return true;
             }
-            collisions++; 
         }
         return false;
     }
 
-    int count_clusters() const {
-        int clusters = 0;
+    // Probe sequence lengths of the stored keys, assuming they were all inserted with Probe.
+    // Unsuccessful cost is averaged over every home slot.
+    template <typename Probe>
+    ProbeStats probe_stats() const {
+        ProbeStats stats;
+        size_t totalHit = 0;
+        for (size_t index = 0; index < M; ++index) {
+            if (!table[index].hasValue) {
+                continue;
+            }
+            typename Probe::Cursor probe(get_hash(table[index].key), M);
+            size_t psl = 0;
+            while (*probe != index && psl < M) {
+                probe.next();
+                psl++;
+            }
+            if (stats.histogram.size() <= psl) {
+                stats.histogram.resize(psl + 1);
+            }
+            stats.histogram[psl]++;
+            stats.maxPSL = std::max(stats.maxPSL, psl);
+            totalHit += psl + 1;
+        }
+
+        size_t totalMiss = 0;
+        for (size_t home = 0; home < M; ++home) {
+            typename Probe::Cursor probe(home, M);
+            size_t i = 0;
+            while (i < M && table[*probe].hasValue && !(Probe::early_exit && distance(*probe) < i)) {
+                probe.next();
+                i++;
+            }
+            totalMiss += std::min(i + 1, M);
+        }
+
+        stats.avgSuccessful = filled ? static_cast<double>(totalHit) / filled : 0;
+        stats.avgUnsuccessful = static_cast<double>(totalMiss) / M;
+        return stats;
+    }
+
+    size_t count_clusters() const {
+        size_t clusters = 0;
         bool in_cluster = false;
         for (const auto& cell : table) {
             if (cell.hasValue) {
@@ -73,97 +361,1577 @@ public:
         return clusters;
     }
 
-    int get_collisions() const {
+    uint64_t get_collisions() const {
         return collisions;
     }
+
+    [[nodiscard]] size_t size() const {
+        return filled;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return M;
+    }
+
+    [[nodiscard]] size_t memory_bytes() const {
+        return table.capacity() * sizeof(Value);
+    }
 };
 
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Probe = QuadraticProbe,
+          typename HashPolicy = DefaultHashPolicy>
+class OpenAddressingTable {
+private:
+    enum class State : uint8_t { Empty, Full, Deleted };
 
-void test_hashing(size_t size, double fill_factor, int iterations, std::ofstream& output) {
-    std::cout << "Table size: " << size << ", Fill factor: " << fill_factor * 100 << "%" << std::endl;
+    struct Slot {
+        Key key{};
+        Value value{};
+        State state = State::Empty;
+    };
 
-    std::random_device rand_dev;
-    std::mt19937 rand_engine(rand_dev());
-    std::uniform_int_distribution<int> unif(0, 10000);
+    std::vector<Slot> table;
+    HashPolicy policy;
+    size_t count = 0;
+    size_t tombstones = 0;
+    double maxLoadFactor;
+    Hash hasher;
 
-    std::vector<double> cubic_times, quadratic_times;
-    std::vector<int> cubic_clusters, quadratic_clusters;
-    std::vector<int> cubic_collisions, quadratic_collisions;
+    [[nodiscard]] size_t get_hash(const Key& key) const {
+        return policy(static_cast<uint64_t>(hasher(key)));
+    }
 
-    for (int it = 0; it < iterations; ++it) {
-        HashTable quadraticTable(size);
-        HashTable cubicTable(size);
+    size_t find_index(const Key& key) const {
+        typename Probe::Cursor probe(get_hash(key), table.size());
+        for (size_t i = 0; i < table.size(); ++i, probe.next()) {
+            size_t index = *probe;
+            if (table[index].state == State::Empty) {
+                return table.size();
+            }
+            if (table[index].state == State::Full && table[index].key == key) {
+                return index;
+            }
+        }
+        return table.size();
+    }
 
-        int max_insertions = static_cast<int>(size * fill_factor);
-        int inserted = 0;
-        int key;
+    void rehash(size_t newCapacity) {
+        std::vector<Slot> old(HashPolicy::table_size(newCapacity));
+        old.swap(table);
+        policy = HashPolicy(table.size());
+        count = 0;
+        tombstones = 0;
+        for (auto& slot : old) {
+            if (slot.state == State::Full) {
+                insert(std::move(slot.key), std::move(slot.value));
+            }
+        }
+    }
 
-        auto start = std::chrono::high_resolution_clock::now();
-        while (inserted < max_insertions) {
-            key = unif(rand_engine);
-            if (cubicTable.cubic_insert(key)) {
-                inserted++;
+public:
+    explicit OpenAddressingTable(size_t capacity = 17, double maxLoadFactor = 0.7, const Hash& hasher = Hash())
+        : table(HashPolicy::table_size(capacity)), policy(table.size()), maxLoadFactor(clamp_load_factor(maxLoadFactor)), hasher(hasher) {}
+
+    Value* find(const Key& key) {
+        size_t index = find_index(key);
+        return index == table.size() ? nullptr : &table[index].value;
+    }
+
+    const Value* find(const Key& key) const {
+        size_t index = find_index(key);
+        return index == table.size() ? nullptr : &table[index].value;
+    }
+
+    bool contains(const Key& key) const {
+        return find_index(key) != table.size();
+    }
+
+    // Returns true if the key was new, false if an existing value was overwritten.
+    bool insert(Key key, Value value) {
+        if (count + tombstones + 1 > maxLoadFactor * table.size()) {
+            rehash(count + 1 > maxLoadFactor * table.size() / 2 ? table.size() * 2 + 1 : table.size());
+        }
+
+        typename Probe::Cursor probe(get_hash(key), table.size());
+        size_t target = table.size();
+        for (size_t i = 0; i < table.size(); ++i, probe.next()) {
+            size_t index = *probe;
+            Slot& slot = table[index];
+            if (slot.state == State::Full && slot.key == key) {
+                slot.value = std::move(value);
+                return false;
+            }
+            if (slot.state == State::Deleted && target == table.size()) {
+                target = index;
+            }
+            if (slot.state == State::Empty) {
+                if (target == table.size()) {
+                    target = index;
+                }
+                break;
             }
         }
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> time_cubic = end - start;
-        cubic_times.push_back(time_cubic.count());
-        cubic_clusters.push_back(cubicTable.count_clusters());
-        cubic_collisions.push_back(cubicTable.get_collisions());
-
-        inserted = 0;
-        start = std::chrono::high_resolution_clock::now();
-        while (inserted < max_insertions) {
-            key = unif(rand_engine);
-            if (quadraticTable.quadratic_insert(key)) {
-                inserted++;
-            }
-        }
-        end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> time_quadratic = end - start;
-        quadratic_times.push_back(time_quadratic.count());
-        quadratic_clusters.push_back(quadraticTable.count_clusters());
-        quadratic_collisions.push_back(quadraticTable.get_collisions());
-    }
-
-    double avg_cubic_time = std::accumulate(cubic_times.begin(), cubic_times.end(), 0.0) / iterations;
-    double avg_quadratic_time = std::accumulate(quadratic_times.begin(), quadratic_times.end(), 0.0) / iterations;
-    double avg_cubic_clusters = std::accumulate(cubic_clusters.begin(), cubic_clusters.end(), 0.0) / iterations;
-    double avg_quadratic_clusters = std::accumulate(quadratic_clusters.begin(), quadratic_clusters.end(), 0.0) / iterations;
-    double avg_cubic_collisions = std::accumulate(cubic_collisions.begin(), cubic_collisions.end(), 0.0) / iterations;
-    double avg_quadratic_collisions = std::accumulate(quadratic_collisions.begin(), quadratic_collisions.end(), 0.0) / iterations;
-
-    std::cout << "Cubic Probing (avg over " << iterations << " runs):" << std::endl;
-    std::cout << "  Avg Time: " << avg_cubic_time << " sec" << std::endl;
-    std::cout << "  Avg Clusters: " << avg_cubic_clusters << std::endl;
-    std::cout << "  Avg Collisions: " << avg_cubic_collisions << std::endl;
-
-    std::cout << "Quadratic Probing (avg over " << iterations << " runs):" << std::endl;
-    std::cout << "  Avg Time: " << avg_quadratic_time << " sec" << std::endl;
-    std::cout << "  Avg Clusters: " << avg_quadratic_clusters << std::endl;
-    std::cout << "  Avg Collisions: " << avg_quadratic_collisions << std::endl;
 
-    std::cout << "---------------------------------------\n";
+        if (target == table.size()) {
+            rehash(table.size() * 2 + 1);
+            return insert(std::move(key), std::move(value));
+        }
 
-    output << size << "," << fill_factor << "," << avg_cubic_time << "," << avg_quadratic_time << ","
-           << avg_cubic_clusters << "," << avg_quadratic_clusters << ","
-           << avg_cubic_collisions << "," << avg_quadratic_collisions << "\n";
-}
+        if (table[target].state == State::Deleted) {
+            tombstones--;
+        }
+        table[target].key = std::move(key);
+        table[target].value = std::move(value);
+        table[target].state = State::Full;
+        count++;
+        return true;
+    }
 
-int main() {
-    std::ofstream output("results.csv");
-    output << "Size,FillFactor,CubicTime,QuadraticTime,CubicClusters,QuadraticClusters,CubicCollisions,QuadraticCollisions\n";
+    bool erase(const Key& key) {
+        size_t index = find_index(key);
+        if (index == table.size()) {
+            return false;
+        }
+        table[index].state = State::Deleted;
+        table[index].key = Key();
+        table[index].value = Value();
+        count--;
+        tombstones++;
+        return true;
+    }
 
-    size_t test_sizes[] = {23, 101, 503, 1009};  
-    double fill_factors[] = {0.3, 0.4, 0.5, 0.6, 0.7}; 
-    int iterations = 30;  
+    void clear() {
+        table.assign(table.size(), Slot());
+        count = 0;
+        tombstones = 0;
+    }
 
-    for (size_t size : test_sizes) {
-        for (double fill_factor : fill_factors) {
-            test_hashing(size, fill_factor, iterations, output);
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return table.size();
+    }
+
+    [[nodiscard]] size_t memory_bytes() const {
+        return table.capacity() * sizeof(Slot);
+    }
+
+    [[nodiscard]] double load_factor() const {
+        return static_cast<double>(count) / table.size();
+    }
+};
+
+// Key-only linear-probing set: slots hold nothing but the key, and a reserved key value marks
+// empty slots, so an int set costs 4 bytes per slot instead of a padded key/flag pair. The
+// reserved key itself is tracked by a flag. Erase shifts later entries of the run back
+// instead of leaving tombstones.
+template <typename Key, typename Hash = std::hash<Key>, typename HashPolicy = DefaultHashPolicy>
+class CompactHashSet {
+private:
+    std::vector<Key> keys;
+    HashPolicy policy;
+    Key emptyKey;
+    bool hasEmptyKey = false;
+    size_t count = 0;
+    double maxLoadFactor;
+    Hash hasher;
+
+    [[nodiscard]] size_t get_hash(const Key& key) const {
+        return policy(static_cast<uint64_t>(hasher(key)));
+    }
+
+    [[nodiscard]] size_t next(size_t index) const {
+        return index + 1 == keys.size() ? 0 : index + 1;
+    }
+
+    size_t find_index(const Key& key) const {
+        size_t index = get_hash(key);
+        while (!(keys[index] == emptyKey)) {
+            if (keys[index] == key) {
+                return index;
+            }
+            index = next(index);
         }
+        return keys.size();
     }
 
-    output.close();
-    return 0;
-}
\ No newline at end of file
+    void rehash(size_t newCapacity) {
+        std::vector<Key> old(HashPolicy::table_size(newCapacity), emptyKey);
+        old.swap(keys);
+        policy = HashPolicy(keys.size());
+        for (const Key& key : old) {
+            if (!(key == emptyKey)) {
+                size_t index = get_hash(key);
+                while (!(keys[index] == emptyKey)) {
+                    index = next(index);
+                }
+                keys[index] = key;
+            }
+        }
+    }
+
+public:
+    explicit CompactHashSet(size_t capacity = 17, double maxLoadFactor = 0.8,
+                            Key emptyKey = std::numeric_limits<Key>::max(), const Hash& hasher = Hash())
+        : keys(HashPolicy::table_size(std::max<size_t>(capacity, 2)), emptyKey), policy(keys.size()),
+          emptyKey(emptyKey), maxLoadFactor(clamp_load_factor(maxLoadFactor)), hasher(hasher) {}
+
+    bool contains(const Key& key) const {
+        if (key == emptyKey) {
+            return hasEmptyKey;
+        }
+        return find_index(key) != keys.size();
+    }
+
+    bool insert(const Key& key) {
+        if (key == emptyKey) {
+            bool inserted = !hasEmptyKey;
+            hasEmptyKey = true;
+            return inserted;
+        }
+        if (count + 1 > maxLoadFactor * keys.size()) {
+            rehash(keys.size() * 2);
+        }
+        size_t index = get_hash(key);
+        while (!(keys[index] == emptyKey)) {
+            if (keys[index] == key) {
+                return false;
+            }
+            index = next(index);
+        }
+        keys[index] = key;
+        count++;
+        return true;
+    }
+
+    bool erase(const Key& key) {
+        if (key == emptyKey) {
+            bool erased = hasEmptyKey;
+            hasEmptyKey = false;
+            return erased;
+        }
+        size_t hole = find_index(key);
+        if (hole == keys.size()) {
+            return false;
+        }
+        for (size_t index = next(hole); !(keys[index] == emptyKey); index = next(index)) {
+            size_t home = get_hash(keys[index]);
+            bool homeInGap = hole <= index ? (home > hole && home <= index) : (home > hole || home <= index);
+            if (!homeInGap) {
+                keys[hole] = keys[index];
+                hole = index;
+            }
+        }
+        keys[hole] = emptyKey;
+        count--;
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count + hasEmptyKey;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return keys.size();
+    }
+
+    [[nodiscard]] size_t memory_bytes() const {
+        return keys.capacity() * sizeof(Key);
+    }
+};
+
+class ControlGroup {
+public:
+    static constexpr size_t width = 16;
+    static constexpr int8_t empty = -128;
+    static constexpr int8_t deleted = -2;
+
+    explicit ControlGroup(const int8_t* ctrl) : ctrl(ctrl) {}
+
+#if defined(__SSE2__)
+    [[nodiscard]] uint32_t match(int8_t h2) const {
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), group));
+    }
+
+    [[nodiscard]] uint32_t match_empty_or_deleted() const {
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return _mm_movemask_epi8(group);
+    }
+#else
+    [[nodiscard]] uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    [[nodiscard]] uint32_t match_empty_or_deleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] < 0) << i;
+        }
+        return mask;
+    }
+#endif
+
+    [[nodiscard]] uint32_t match_empty() const {
+        return match(empty);
+    }
+
+private:
+    const int8_t* ctrl;
+};
+
+// Control bytes live apart from the slots: a full slot stores the low 7 bits of its hash,
+// empty and deleted slots are negative, so one 16-byte load filters a whole group.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SwissTable {
+private:
+    struct Slot {
+        Key key{};
+        Value value{};
+    };
+
+    std::vector<int8_t> ctrl;
+    std::vector<Slot> slots;
+    size_t groupMask;
+    size_t count = 0;
+    size_t tombstones = 0;
+    Hash hasher;
+
+    // The group is taken from the low bits and h2 from the top 7, so the key is fully mixed
+    // first: after a plain multiply the low bits depend only on the low bits of the key.
+    [[nodiscard]] size_t get_hash(const Key& key) const {
+        return static_cast<size_t>(MurmurMix::mix(static_cast<uint64_t>(hasher(key))));
+    }
+
+    static int8_t h2(size_t hash) {
+        return static_cast<int8_t>(hash >> (sizeof(size_t) * 8 - 7));
+    }
+
+    static constexpr size_t batchBlock = 256;
+    static constexpr size_t prefetchDistance = 8;
+
+    void hash_block(const Key* keys, size_t n, size_t* hashes) const {
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = get_hash(keys[i]);
+        }
+        for (size_t i = 0; i < std::min(n, prefetchDistance); ++i) {
+            prefetch(hashes[i]);
+        }
+    }
+
+    [[nodiscard]] size_t max_filled() const {
+        return slots.size() / 8 * 7;
+    }
+
+    size_t find_index(const Key& key) const {
+        return find_index(key, get_hash(key));
+    }
+
+    size_t find_index(const Key& key, size_t hash) const {
+        int8_t tag = h2(hash);
+        size_t group = hash & groupMask;
+        for (size_t step = 1;; ++step) {
+            ControlGroup g(&ctrl[group * ControlGroup::width]);
+            for (uint32_t mask = g.match(tag); mask; mask &= mask - 1) {
+                size_t index = group * ControlGroup::width + __builtin_ctz(mask);
+                if (slots[index].key == key) {
+                    return index;
+                }
+            }
+            if (g.match_empty()) {
+                return slots.size();
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    size_t find_free(size_t hash) const {
+        size_t group = hash & groupMask;
+        for (size_t step = 1;; ++step) {
+            uint32_t mask = ControlGroup(&ctrl[group * ControlGroup::width]).match_empty_or_deleted();
+            if (mask) {
+                return group * ControlGroup::width + __builtin_ctz(mask);
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void prefetch(size_t hash) const {
+        size_t group = hash & groupMask;
+        __builtin_prefetch(&ctrl[group * ControlGroup::width]);
+        __builtin_prefetch(&slots[group * ControlGroup::width]);
+    }
+
+    bool insert_hashed(Key key, Value value, size_t hash) {
+        size_t index = find_index(key, hash);
+        if (index != slots.size()) {
+            slots[index].value = std::move(value);
+            return false;
+        }
+        if (count + tombstones + 1 > max_filled()) {
+            size_t groups = groupMask + 1;
+            rehash(count + 1 > max_filled() / 2 ? groups * 2 : groups);
+        }
+        index = find_free(hash);
+        if (ctrl[index] == ControlGroup::deleted) {
+            tombstones--;
+        }
+        ctrl[index] = h2(hash);
+        slots[index].key = std::move(key);
+        slots[index].value = std::move(value);
+        count++;
+        return true;
+    }
+
+    void rehash(size_t groups) {
+        std::vector<int8_t> oldCtrl(groups * ControlGroup::width, ControlGroup::empty);
+        std::vector<Slot> oldSlots(groups * ControlGroup::width);
+        oldCtrl.swap(ctrl);
+        oldSlots.swap(slots);
+        groupMask = groups - 1;
+        count = 0;
+        tombstones = 0;
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldCtrl[i] >= 0) {
+                size_t hash = get_hash(oldSlots[i].key);
+                size_t index = find_free(hash);
+                ctrl[index] = h2(hash);
+                slots[index] = std::move(oldSlots[i]);
+                count++;
+            }
+        }
+    }
+
+public:
+    explicit SwissTable(size_t capacity = 16, const Hash& hasher = Hash()) : hasher(hasher) {
+        size_t groups = 1;
+        while (groups * ControlGroup::width / 8 * 7 < capacity) {
+            groups *= 2;
+        }
+        ctrl.assign(groups * ControlGroup::width, ControlGroup::empty);
+        slots.resize(groups * ControlGroup::width);
+        groupMask = groups - 1;
+    }
+
+    Value* find(const Key& key) {
+        size_t index = find_index(key);
+        return index == slots.size() ? nullptr : &slots[index].value;
+    }
+
+    const Value* find(const Key& key) const {
+        size_t index = find_index(key);
+        return index == slots.size() ? nullptr : &slots[index].value;
+    }
+
+    bool contains(const Key& key) const {
+        return find_index(key) != slots.size();
+    }
+
+    bool insert(Key key, Value value) {
+        size_t hash = get_hash(key);
+        return insert_hashed(std::move(key), std::move(value), hash);
+    }
+
+    // Groups a lookup of key visits, counting the one it stops in.
+    [[nodiscard]] size_t probe_groups(const Key& key) const {
+        size_t hash = get_hash(key);
+        int8_t tag = h2(hash);
+        size_t group = hash & groupMask;
+        for (size_t step = 1;; ++step) {
+            ControlGroup g(&ctrl[group * ControlGroup::width]);
+            for (uint32_t mask = g.match(tag); mask; mask &= mask - 1) {
+                if (slots[group * ControlGroup::width + __builtin_ctz(mask)].key == key) {
+                    return step;
+                }
+            }
+            if (g.match_empty()) {
+                return step;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void reserve(size_t capacity) {
+        size_t groups = groupMask + 1;
+        while (groups * ControlGroup::width / 8 * 7 < capacity) {
+            groups *= 2;
+        }
+        if (groups != groupMask + 1) {
+            rehash(groups);
+        }
+    }
+
+    // Bulk operations hash a block of keys up front and prefetch the home group of the key
+    // prefetchDistance positions ahead, so the cache misses of neighbouring keys overlap.
+    // results[i] receives what the scalar call would have returned for keys[i].
+    void insert_batch(const Key* keys, const Value* values, size_t n, uint8_t* results) {
+        reserve(count + n);
+        size_t hashes[batchBlock];
+        for (size_t block = 0; block < n; block += batchBlock) {
+            size_t size = std::min(batchBlock, n - block);
+            hash_block(keys + block, size, hashes);
+            for (size_t i = 0; i < size; ++i) {
+                if (i + prefetchDistance < size) {
+                    prefetch(hashes[i + prefetchDistance]);
+                }
+                results[block + i] = insert_hashed(keys[block + i], values[block + i], hashes[i]);
+            }
+        }
+    }
+
+    void contains_batch(const Key* keys, size_t n, uint8_t* results) const {
+        size_t hashes[batchBlock];
+        for (size_t block = 0; block < n; block += batchBlock) {
+            size_t size = std::min(batchBlock, n - block);
+            hash_block(keys + block, size, hashes);
+            for (size_t i = 0; i < size; ++i) {
+                if (i + prefetchDistance < size) {
+                    prefetch(hashes[i + prefetchDistance]);
+                }
+                results[block + i] = find_index(keys[block + i], hashes[i]) != slots.size();
+            }
+        }
+    }
+
+    bool erase(const Key& key) {
+        size_t index = find_index(key);
+        if (index == slots.size()) {
+            return false;
+        }
+        size_t group = index / ControlGroup::width;
+        // A probe only continues past a group that has no empty slot, so the slot may
+        // become empty again as long as its group still stops probes on its own.
+        if (ControlGroup(&ctrl[group * ControlGroup::width]).match_empty()) {
+            ctrl[index] = ControlGroup::empty;
+        } else {
+            ctrl[index] = ControlGroup::deleted;
+            tombstones++;
+        }
+        slots[index] = Slot();
+        count--;
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return slots.size();
+    }
+
+    [[nodiscard]] size_t memory_bytes() const {
+        return ctrl.capacity() + slots.capacity() * sizeof(Slot);
+    }
+
+    [[nodiscard]] double load_factor() const {
+        return static_cast<double>(count) / slots.size();
+    }
+};
+
+// Bucketized cuckoo hashing: every key lives in one of the 4 slots of its two candidate
+// buckets, chosen by independent hash functions, so a lookup reads exactly two buckets.
+// Inserts that find both buckets full search breadth-first for the shortest chain of
+// displacements ending in a free slot, and the table doubles if none is found.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class CuckooTable {
+private:
+    static constexpr size_t ways = 4;
+    static constexpr size_t maxSearch = 512;
+
+    struct Bucket {
+        uint8_t occupied = 0;
+        Key keys[ways]{};
+        Value values[ways]{};
+    };
+
+    struct SearchNode {
+        size_t bucket;
+        size_t parent;
+        size_t slot;
+    };
+
+    std::vector<Bucket> buckets;
+    size_t bucketMask;
+    size_t count = 0;
+    Hash hasher;
+
+    [[nodiscard]] size_t first_bucket(const Key& key) const {
+        return MurmurMix::mix(static_cast<uint64_t>(hasher(key))) & bucketMask;
+    }
+
+    [[nodiscard]] size_t second_bucket(const Key& key) const {
+        return WyMix::mix(static_cast<uint64_t>(hasher(key))) & bucketMask;
+    }
+
+    [[nodiscard]] size_t alternate(const Key& key, size_t bucket) const {
+        size_t first = first_bucket(key);
+        return first == bucket ? second_bucket(key) : first;
+    }
+
+    int find_slot(const Bucket& bucket, const Key& key) const {
+        for (size_t s = 0; s < ways; ++s) {
+            if ((bucket.occupied >> s & 1) && bucket.keys[s] == key) {
+                return static_cast<int>(s);
+            }
+        }
+        return -1;
+    }
+
+    static int free_slot(const Bucket& bucket) {
+        return bucket.occupied == (1u << ways) - 1 ? -1 : __builtin_ctz(~bucket.occupied);
+    }
+
+    void place(size_t b, size_t s, Key key, Value value) {
+        buckets[b].keys[s] = std::move(key);
+        buckets[b].values[s] = std::move(value);
+        buckets[b].occupied |= 1u << s;
+    }
+
+    bool make_room(size_t b1, size_t b2, size_t& bucket, size_t& slot) {
+        std::vector<SearchNode> nodes = {{b1, SIZE_MAX, 0}, {b2, SIZE_MAX, 0}};
+        for (size_t head = 0; head < nodes.size() && nodes.size() < maxSearch; ++head) {
+            const Bucket& current = buckets[nodes[head].bucket];
+            int free = free_slot(current);
+            if (free >= 0) {
+                size_t node = head;
+                size_t hole = free;
+                while (nodes[node].parent != SIZE_MAX) {
+                    const SearchNode& parent = nodes[nodes[node].parent];
+                    Bucket& from = buckets[parent.bucket];
+                    size_t s = nodes[node].slot;
+                    place(nodes[node].bucket, hole, std::move(from.keys[s]), std::move(from.values[s]));
+                    from.occupied &= ~(1u << s);
+                    hole = s;
+                    node = nodes[node].parent;
+                }
+                bucket = nodes[node].bucket;
+                slot = hole;
+                return true;
+            }
+            for (size_t s = 0; s < ways; ++s) {
+                nodes.push_back({alternate(current.keys[s], nodes[head].bucket), head, s});
+            }
+        }
+        return false;
+    }
+
+    void rehash(size_t bucketCount) {
+        std::vector<Bucket> old(bucketCount);
+        old.swap(buckets);
+        bucketMask = bucketCount - 1;
+        count = 0;
+        for (auto& bucket : old) {
+            for (size_t s = 0; s < ways; ++s) {
+                if (bucket.occupied >> s & 1) {
+                    insert(std::move(bucket.keys[s]), std::move(bucket.values[s]));
+                }
+            }
+        }
+    }
+
+public:
+    explicit CuckooTable(size_t capacity = 16, const Hash& hasher = Hash()) : hasher(hasher) {
+        size_t bucketCount = 2;
+        while (bucketCount * ways * 0.9 < capacity) {
+            bucketCount *= 2;
+        }
+        buckets.resize(bucketCount);
+        bucketMask = bucketCount - 1;
+    }
+
+    Value* find(const Key& key) {
+        return const_cast<Value*>(static_cast<const CuckooTable*>(this)->find(key));
+    }
+
+    const Value* find(const Key& key) const {
+        const Bucket& first = buckets[first_bucket(key)];
+        int s = find_slot(first, key);
+        if (s >= 0) {
+            return &first.values[s];
+        }
+        const Bucket& second = buckets[second_bucket(key)];
+        s = find_slot(second, key);
+        return s >= 0 ? &second.values[s] : nullptr;
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    bool insert(Key key, Value value) {
+        if (Value* existing = find(key)) {
+            *existing = std::move(value);
+            return false;
+        }
+        size_t b1 = first_bucket(key);
+        size_t b2 = second_bucket(key);
+        int s = free_slot(buckets[b1]);
+        size_t bucket = b1;
+        size_t slot = s;
+        if (s < 0) {
+            s = free_slot(buckets[b2]);
+            bucket = b2;
+            slot = s;
+        }
+        if (s < 0 && !make_room(b1, b2, bucket, slot)) {
+            rehash(buckets.size() * 2);
+            return insert(std::move(key), std::move(value));
+        }
+        place(bucket, slot, std::move(key), std::move(value));
+        count++;
+        return true;
+    }
+
+    bool erase(const Key& key) {
+        for (size_t b : {first_bucket(key), second_bucket(key)}) {
+            int s = find_slot(buckets[b], key);
+            if (s >= 0) {
+                buckets[b].occupied &= ~(1u << s);
+                buckets[b].keys[s] = Key();
+                buckets[b].values[s] = Value();
+                count--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return buckets.size() * ways;
+    }
+
+    [[nodiscard]] double load_factor() const {
+        return static_cast<double>(count) / capacity();
+    }
+
+    [[nodiscard]] size_t memory_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+};
+
+struct alignas(64) ThreadCounters {
+    size_t inserts = 0;
+    size_t lookups = 0;
+    size_t collisions = 0;
+};
+
+// Lock-free linear-probing set of ints. Inserts claim empty slots with CAS, lookups never
+// write. On resize every thread that touches the old table helps migrate it chunk by chunk:
+// migrated slots are frozen, and once the next table exists inserts seal their empty slot
+// instead of filling it, so a lookup that meets a frozen slot knows to continue in the next
+// table. Old tables stay chained behind the first one until destruction, so readers never
+// see freed memory.
+class ConcurrentHashTable {
+private:
+    static constexpr uint64_t present = 1ull << 32;
+    static constexpr uint64_t frozen = 1ull << 63;
+    static constexpr size_t chunk = 1024;
+
+    enum class Result { Inserted, Found, Moved, Full };
+
+    struct Table {
+        size_t M;
+        DefaultHashPolicy policy;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        size_t chunks;
+        std::atomic<size_t> count{0};
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> doneChunks{0};
+        std::atomic<Table*> next{nullptr};
+
+        explicit Table(size_t size)
+            : M(size), policy(size), slots(new std::atomic<uint64_t>[size]), chunks((size + chunk - 1) / chunk) {
+            for (size_t i = 0; i < M; ++i) {
+                slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    Table* first;
+    std::atomic<Table*> root;
+    double maxLoadFactor;
+
+    static uint64_t encode(int key) {
+        return static_cast<uint32_t>(key) | present;
+    }
+
+    static size_t home(const Table* t, uint64_t value) {
+        return t->policy(static_cast<int64_t>(static_cast<int32_t>(value)));
+    }
+
+    static Result insert_into(Table* t, uint64_t value, ThreadCounters& stats) {
+        bool sealing = t->next.load(std::memory_order_acquire) != nullptr;
+        LinearProbe::Cursor probe(home(t, value), t->M);
+        for (size_t i = 0; i < t->M; ++i, probe.next()) {
+            std::atomic<uint64_t>& slot = t->slots[*probe];
+            uint64_t cur = slot.load(std::memory_order_acquire);
+            while (true) {
+                if ((cur & ~frozen) == value) {
+                    return Result::Found;
+                }
+                if (cur == frozen) {
+                    return Result::Moved;
+                }
+                if (cur & frozen) {
+                    sealing = true;
+                    break;
+                }
+                if (cur != 0) {
+                    break;
+                }
+                if (slot.compare_exchange_weak(cur, sealing ? frozen : value, std::memory_order_acq_rel)) {
+                    if (sealing) {
+                        return Result::Moved;
+                    }
+                    t->count.fetch_add(1, std::memory_order_relaxed);
+                    return Result::Inserted;
+                }
+            }
+            stats.collisions++;
+        }
+        return Result::Full;
+    }
+
+    Table* start_resize(Table* t) {
+        Table* next = t->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            Table* fresh = new Table(t->M * 2);
+            if (t->next.compare_exchange_strong(next, fresh, std::memory_order_acq_rel)) {
+                next = fresh;
+            } else {
+                delete fresh;
+            }
+        }
+        return next;
+    }
+
+    void help_migrate(Table* t, Table* next, ThreadCounters& stats) {
+        size_t c;
+        while ((c = t->nextChunk.fetch_add(1, std::memory_order_relaxed)) < t->chunks) {
+            size_t end = std::min(t->M, (c + 1) * chunk);
+            for (size_t i = c * chunk; i < end; ++i) {
+                uint64_t cur = t->slots[i].load(std::memory_order_acquire);
+                while (!(cur & frozen) && !t->slots[i].compare_exchange_weak(cur, cur | frozen, std::memory_order_acq_rel)) {
+                }
+                if (!(cur & frozen) && cur != 0) {
+                    insert_value(next, cur, stats);
+                }
+            }
+            if (t->doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == t->chunks) {
+                advance_root();
+            }
+        }
+    }
+
+    static bool migrated(const Table* t) {
+        return t->doneChunks.load(std::memory_order_acquire) == t->chunks;
+    }
+
+    // Moves root past every fully migrated table. Nested migrations can finish out of order,
+    // so the one that finishes last may find root several tables behind, or already ahead.
+    void advance_root() {
+        Table* current = root.load(std::memory_order_acquire);
+        while (true) {
+            Table* target = current;
+            while (migrated(target)) {
+                target = target->next.load(std::memory_order_acquire);
+            }
+            if (target == current || root.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+    bool insert_value(Table* t, uint64_t value, ThreadCounters& stats) {
+        while (true) {
+            if (t->next.load(std::memory_order_acquire) == nullptr &&
+                t->count.load(std::memory_order_relaxed) + 1 > maxLoadFactor * t->M) {
+                start_resize(t);
+            }
+            Result result = insert_into(t, value, stats);
+            if (result == Result::Inserted) {
+                return true;
+            }
+            if (result == Result::Found) {
+                return false;
+            }
+            Table* next = start_resize(t);
+            help_migrate(t, next, stats);
+            t = next;
+        }
+    }
+
+public:
+    explicit ConcurrentHashTable(size_t capacity = 1024, double maxLoadFactor = 0.5)
+        : first(new Table(std::max<size_t>(capacity, 2))), root(first), maxLoadFactor(clamp_load_factor(maxLoadFactor)) {}
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    ~ConcurrentHashTable() {
+        Table* t = first;
+        while (t != nullptr) {
+            Table* next = t->next.load(std::memory_order_relaxed);
+            delete t;
+            t = next;
+        }
+    }
+
+    bool insert(int key, ThreadCounters& stats) {
+        stats.inserts++;
+        return insert_value(root.load(std::memory_order_acquire), encode(key), stats);
+    }
+
+    bool contains(int key, ThreadCounters& stats) const {
+        stats.lookups++;
+        uint64_t value = encode(key);
+        const Table* t = root.load(std::memory_order_acquire);
+        while (t != nullptr) {
+            LinearProbe::Cursor probe(home(t, value), t->M);
+            size_t i = 0;
+            for (; i < t->M; ++i, probe.next()) {
+                uint64_t cur = t->slots[*probe].load(std::memory_order_acquire);
+                if ((cur & ~frozen) == value) {
+                    return true;
+                }
+                if (cur == 0) {
+                    return false;
+                }
+                if (cur == frozen) {
+                    break;
+                }
+                stats.collisions++;
+            }
+            t = t->next.load(std::memory_order_acquire);
+        }
+        return false;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return root.load(std::memory_order_acquire)->M;
+    }
+
+    // Capacity of the last table in the chain; equals capacity() once no migration is running.
+    [[nodiscard]] size_t newest_capacity() const {
+        const Table* t = first;
+        while (const Table* next = t->next.load(std::memory_order_acquire)) {
+            t = next;
+        }
+        return t->M;
+    }
+};
+
+struct SchemeSummary {
+    std::string name;
+    std::vector<double> times;
+    std::vector<double> lookup_times;
+    std::vector<double> bytes_per_key;
+    std::vector<uint64_t> clusters;
+    std::vector<uint64_t> collisions;
+    std::vector<double> max_psl, p99_psl, avg_hit, avg_miss;
+    std::vector<size_t> histogram;
+
+    explicit SchemeSummary(std::string name) : name(std::move(name)) {}
+
+    void add_stats(const ProbeStats& stats) {
+        max_psl.push_back(stats.maxPSL);
+        p99_psl.push_back(stats.percentile(0.99));
+        avg_hit.push_back(stats.avgSuccessful);
+        avg_miss.push_back(stats.avgUnsuccessful);
+        if (histogram.size() < stats.histogram.size()) {
+            histogram.resize(stats.histogram.size());
+        }
+        for (size_t psl = 0; psl < stats.histogram.size(); ++psl) {
+            histogram[psl] += stats.histogram[psl];
+        }
+    }
+};
+
+double average(const std::vector<double>& values) {
+    return values.empty() ? 0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double average(const std::vector<uint64_t>& values) {
+    return values.empty() ? 0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+template <typename Table, typename Contains>
+double time_lookups(const Table& table, size_t lookups, std::mt19937& rand_engine,
+                    std::uniform_int_distribution<int>& unif, Contains contains) {
+    std::vector<int> keys(std::max<size_t>(lookups, 1));
+    for (int& key : keys) {
+        key = unif(rand_engine);
+    }
+    size_t hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int key : keys) {
+        hits += contains(table, key);
+    }
+    // The hit count is stored through a volatile inside the timed region, so the lookups can
+    // neither be dropped nor moved past the clock read.
+    volatile size_t sink = hits;
+    (void)sink;
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> time = end - start;
+    return time.count();
+}
+
+template <typename Table, typename Insert>
+void run_table(Table& table, Insert insert, size_t max_insertions, std::mt19937& rand_engine,
+               std::uniform_int_distribution<int>& unif, SchemeSummary& summary) {
+    auto start = std::chrono::high_resolution_clock::now();
+    while (table.size() < max_insertions) {
+        insert(table, unif(rand_engine));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> time = end - start;
+    summary.times.push_back(time.count());
+    summary.lookup_times.push_back(time_lookups(table, max_insertions, rand_engine, unif,
+                                                [](const Table& t, int key) { return t.contains(key); }));
+    summary.bytes_per_key.push_back(static_cast<double>(table.memory_bytes()) / std::max<size_t>(table.size(), 1));
+}
+
+template <typename Probe>
+void run_scheme(size_t size, size_t max_insertions, bool (HashTable<>::*insert)(int),
+                std::mt19937& rand_engine, std::uniform_int_distribution<int>& unif, SchemeSummary& summary) {
+    HashTable<> table(size);
+    size_t attempts = 0;
+    size_t max_attempts = 100 * max_insertions + 100;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    while (table.size() < max_insertions && attempts++ < max_attempts) {
+        (table.*insert)(unif(rand_engine));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> time = end - start;
+
+    summary.times.push_back(time.count());
+    summary.lookup_times.push_back(time_lookups(table, max_insertions, rand_engine, unif,
+                                                [](const HashTable<>& t, int key) { return t.template contains<Probe>(key); }));
+    summary.bytes_per_key.push_back(static_cast<double>(table.memory_bytes()) / std::max<size_t>(table.size(), 1));
+    summary.clusters.push_back(table.count_clusters());
+    summary.collisions.push_back(table.get_collisions());
+    summary.add_stats(table.template probe_stats<Probe>());
+}
+
+void test_hashing(size_t size, double fill_factor, int iterations, std::ostream& output, std::ostream& histogram_output,
+                  std::ostream& log = std::cout) {
+    log << "Table size: " << size << ", Fill factor: " << fill_factor * 100 << "%" << std::endl;
+
+    std::random_device rand_dev;
+    std::mt19937 rand_engine(rand_dev());
+    std::uniform_int_distribution<int> unif(0, 10000);
+
+    SchemeSummary cubic("Cubic"), quadratic("Quadratic"), linear("Linear"), robin_hood("RobinHood");
+    SchemeSummary swiss("Swiss"), cuckoo("Cuckoo"), compact("Compact");
+    size_t max_insertions = static_cast<size_t>(size * fill_factor);
+
+    for (int it = 0; it < iterations; ++it) {
+        run_scheme<CubicProbe>(size, max_insertions, &HashTable<>::cubic_insert, rand_engine, unif, cubic);
+        run_scheme<QuadraticProbe>(size, max_insertions, &HashTable<>::quadratic_insert, rand_engine, unif, quadratic);
+        run_scheme<LinearProbe>(size, max_insertions, &HashTable<>::linear_insert, rand_engine, unif, linear);
+        run_scheme<RobinHoodProbe>(size, max_insertions, &HashTable<>::robin_hood_insert, rand_engine, unif, robin_hood);
+
+        auto insert_pair = [](auto& table, int key) { table.insert(key, true); };
+        SwissTable<int, bool> swissTable(max_insertions);
+        run_table(swissTable, insert_pair, max_insertions, rand_engine, unif, swiss);
+        CuckooTable<int, bool> cuckooTable(max_insertions);
+        run_table(cuckooTable, insert_pair, max_insertions, rand_engine, unif, cuckoo);
+        CompactHashSet<int> compactSet(size, 0.95);
+        run_table(compactSet, [](CompactHashSet<int>& set, int key) { set.insert(key); },
+                  max_insertions, rand_engine, unif, compact);
+    }
+
+    for (const SchemeSummary* scheme : {&cubic, &quadratic, &linear, &robin_hood}) {
+        log << scheme->name << " Probing (avg over " << iterations << " runs):" << std::endl;
+        log << "  Avg Time: " << average(scheme->times) << " sec" << std::endl;
+        log << "  Avg Lookup Time: " << average(scheme->lookup_times) << " sec" << std::endl;
+        log << "  Bytes per Key: " << average(scheme->bytes_per_key) << std::endl;
+        log << "  Avg Clusters: " << average(scheme->clusters) << std::endl;
+        log << "  Avg Collisions: " << average(scheme->collisions) << std::endl;
+        log << "  Avg Max PSL: " << average(scheme->max_psl) << ", P99 PSL: " << average(scheme->p99_psl) << std::endl;
+        log << "  Avg Probes (hit / miss): " << average(scheme->avg_hit) << " / " << average(scheme->avg_miss) << std::endl;
+
+        for (size_t psl = 0; psl < scheme->histogram.size(); ++psl) {
+            histogram_output << size << "," << fill_factor << "," << scheme->name << "," << psl << ","
+                             << scheme->histogram[psl] << "\n";
+        }
+    }
+
+    for (const SchemeSummary* scheme : {&swiss, &cuckoo, &compact}) {
+        log << scheme->name << " (avg over " << iterations << " runs):" << std::endl;
+        log << "  Avg Time: " << average(scheme->times) << " sec" << std::endl;
+        log << "  Avg Lookup Time: " << average(scheme->lookup_times) << " sec" << std::endl;
+        log << "  Bytes per Key: " << average(scheme->bytes_per_key) << std::endl;
+    }
+
+    log << "---------------------------------------\n";
+
+    output << size << "," << fill_factor << "," << average(cubic.times) << "," << average(quadratic.times) << ","
+           << average(cubic.clusters) << "," << average(quadratic.clusters) << ","
+           << average(cubic.collisions) << "," << average(quadratic.collisions) << "," << average(swiss.times);
+    for (const SchemeSummary* scheme : {&linear, &robin_hood}) {
+        output << "," << average(scheme->times) << "," << average(scheme->clusters) << "," << average(scheme->collisions);
+    }
+    for (const SchemeSummary* scheme : {&cubic, &quadratic, &linear, &robin_hood}) {
+        output << "," << average(scheme->max_psl) << "," << average(scheme->p99_psl) << ","
+               << average(scheme->avg_hit) << "," << average(scheme->avg_miss);
+    }
+    output << "," << average(cuckoo.times);
+    for (const SchemeSummary* scheme : {&cubic, &quadratic, &linear, &robin_hood, &swiss, &cuckoo}) {
+        output << "," << average(scheme->lookup_times);
+    }
+    output << "," << average(compact.times) << "," << average(compact.lookup_times);
+    for (const SchemeSummary* scheme : {&cubic, &quadratic, &linear, &robin_hood, &swiss, &cuckoo, &compact}) {
+        output << "," << average(scheme->bytes_per_key);
+    }
+    output << "\n";
+}
+
+void test_concurrent_hashing(size_t operations, int max_threads, std::ofstream& output) {
+    std::cout << "Concurrent table, " << operations << " operations" << std::endl;
+    int key_universe = static_cast<int>(operations / 4);
+    double base_throughput = 0;
+
+    for (int threads = 1; threads <= max_threads; threads = threads < max_threads ? std::min(threads * 2, max_threads) : threads + 1) {
+        ConcurrentHashTable table(1024);
+        std::vector<ThreadCounters> counters(threads);
+        std::vector<std::thread> workers;
+        size_t per_thread = operations / threads;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                std::mt19937 rand_engine(t + 1);
+                std::uniform_int_distribution<int> unif(0, key_universe);
+                for (size_t i = 0; i < per_thread; ++i) {
+                    int key = unif(rand_engine);
+                    if (i % 2 == 0) {
+                        table.insert(key, counters[t]);
+                    } else {
+                        table.contains(key, counters[t]);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> time = end - start;
+
+        size_t collisions = 0;
+        for (const auto& c : counters) {
+            collisions += c.collisions;
+        }
+        double throughput = per_thread * threads / time.count();
+        if (threads == 1) {
+            base_throughput = throughput;
+        }
+
+        std::cout << "  Threads: " << threads << ", Ops/sec: " << throughput
+                  << ", Speedup: " << throughput / base_throughput << ", Collisions: " << collisions << std::endl;
+        output << threads << "," << throughput << "," << throughput / base_throughput << ","
+               << collisions << "," << table.capacity() << "\n";
+    }
+    std::cout << "---------------------------------------\n";
+}
+
+void test_batched_hashing(size_t key_count, std::ofstream& output) {
+    std::cout << "Batched vs scalar SwissTable, " << key_count << " keys" << std::endl;
+
+    std::mt19937 rand_engine(42);
+    std::uniform_int_distribution<int> unif(0, std::numeric_limits<int>::max());
+    std::vector<int> keys(key_count), probes(key_count);
+    for (size_t i = 0; i < key_count; ++i) {
+        keys[i] = unif(rand_engine);
+        probes[i] = i % 2 == 0 ? keys[(i * 7919) % key_count] : unif(rand_engine);
+    }
+    std::unique_ptr<bool[]> value_array(new bool[key_count]);
+    std::fill(value_array.get(), value_array.get() + key_count, true);
+    std::vector<uint8_t> results(key_count);
+
+    auto time_of = [](auto&& body) {
+        auto start = std::chrono::high_resolution_clock::now();
+        body();
+        std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+        return time.count();
+    };
+
+    SwissTable<int, bool> scalarTable(key_count);
+    double scalar_insert = time_of([&]() {
+        for (size_t i = 0; i < key_count; ++i) {
+            results[i] = scalarTable.insert(keys[i], true);
+        }
+    });
+    size_t scalar_hits = 0;
+    double scalar_lookup = time_of([&]() {
+        for (size_t i = 0; i < key_count; ++i) {
+            scalar_hits += scalarTable.contains(probes[i]);
+        }
+    });
+
+    SwissTable<int, bool> batchTable(key_count);
+    double batch_insert = time_of([&]() {
+        batchTable.insert_batch(keys.data(), value_array.get(), key_count, results.data());
+    });
+    double batch_lookup = time_of([&]() {
+        batchTable.contains_batch(probes.data(), key_count, results.data());
+    });
+    size_t batch_hits = std::accumulate(results.begin(), results.end(), size_t(0));
+
+    double n = static_cast<double>(key_count);
+    std::cout << "  Insert Mops/sec (scalar / batch): " << n / scalar_insert / 1e6 << " / " << n / batch_insert / 1e6 << std::endl;
+    std::cout << "  Lookup Mops/sec (scalar / batch): " << n / scalar_lookup / 1e6 << " / " << n / batch_lookup / 1e6 << std::endl;
+    if (scalar_hits != batch_hits) {
+        std::cout << "  Hit count mismatch: " << scalar_hits << " vs " << batch_hits << std::endl;
+    }
+    std::cout << "---------------------------------------\n";
+
+    output << key_count << "," << n / scalar_insert << "," << n / batch_insert << ","
+           << n / scalar_lookup << "," << n / batch_lookup << "\n";
+}
+
+// Keys that differ only in their high bits must still spread over the groups; a weak mix
+// puts all of them in one group and every probe walks the whole cluster.
+bool check_swiss_high_bit_keys(std::ostream& log) {
+    const uint64_t key_count = 100000;
+    SwissTable<uint64_t, bool> table(key_count);
+    for (uint64_t i = 0; i < key_count; ++i) {
+        table.insert(i << 16, true);
+    }
+    size_t groups = 0;
+    bool found = true;
+    for (uint64_t i = 0; i < key_count; ++i) {
+        found = found && table.contains(i << 16);
+        groups += table.probe_groups(i << 16);
+    }
+    double average_groups = static_cast<double>(groups) / key_count;
+    bool ok = found && !table.contains(1) && average_groups < 2.0;
+    log << "Swiss keys spaced by 2^16: " << average_groups << " groups per lookup " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+// Threads grow a small concurrent table through many nested migrations; once they are done,
+// root has to be the newest table and every key has to be found through it.
+bool check_concurrent_root(std::ostream& log) {
+    const int threads = 8;
+    const int keys_per_thread = 1 << 18;
+    bool ok = true;
+    for (int rep = 0; rep < 8; ++rep) {
+        ConcurrentHashTable table(16);
+        std::vector<ThreadCounters> counters(threads);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (int i = 0; i < keys_per_thread; ++i) {
+                    table.insert(i * threads + t, counters[t]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        bool found = true;
+        for (int key = 0; key < threads * keys_per_thread && found; ++key) {
+            found = table.contains(key, counters[0]);
+        }
+        if (!found || table.capacity() != table.newest_capacity()) {
+            log << "  rep " << rep << ": root capacity " << table.capacity() << ", newest " << table.newest_capacity()
+                << (found ? "" : ", keys missing") << std::endl;
+            ok = false;
+        }
+    }
+    log << "Concurrent root after nested growth " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+// Bijective scramble of 32-bit indices, so the i-th generated key is distinct for every i
+// without keeping a set of the keys already produced.
+uint32_t scramble32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+enum class KeyDistribution { Uniform, Zipf, Sequential, Clustered };
+
+const char* distribution_name(KeyDistribution distribution) {
+    switch (distribution) {
+        case KeyDistribution::Uniform: return "Uniform";
+        case KeyDistribution::Zipf: return "Zipf";
+        case KeyDistribution::Sequential: return "Sequential";
+        case KeyDistribution::Clustered: return "Clustered";
+    }
+    return "";
+}
+
+// key(i) is distinct for distinct i, so keys 0..n-1 fill the table and keys n..2n-1 are
+// guaranteed misses. Clustered keys come in runs of 64 consecutive integers, which defeats
+// hashes that only look at the low bits. Zipf only skews which inserted keys are looked up.
+class KeyStream {
+public:
+    explicit KeyStream(KeyDistribution distribution) : distribution(distribution) {}
+
+    int key(uint64_t i) const {
+        uint32_t x = static_cast<uint32_t>(i);
+        switch (distribution) {
+            case KeyDistribution::Sequential:
+                return static_cast<int>(x);
+            case KeyDistribution::Clustered:
+                return static_cast<int>((((x >> 6) * 0x9E3779B1u) << 6) | (x & 63));
+            default:
+                return static_cast<int>(scramble32(x));
+        }
+    }
+
+private:
+    KeyDistribution distribution;
+};
+
+class LatencySampler {
+public:
+    static constexpr size_t every = 16;
+
+    template <typename Op>
+    void run(size_t i, Op&& op) {
+        if (i % every != 0) {
+            op();
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        op();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    double percentile(double q) {
+        if (samples.empty()) {
+            return 0;
+        }
+        size_t rank = std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()));
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank];
+    }
+
+private:
+    std::vector<int64_t> samples;
+};
+
+long page_faults() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+template <typename Table, typename Insert, typename Contains>
+void run_sweep_cell(const char* engine, Table& table, Insert insert, Contains contains, size_t slots,
+                    size_t entries, KeyDistribution distribution, std::ofstream& output) {
+    KeyStream stream(distribution);
+    LatencySampler insert_latency, hit_latency, miss_latency;
+    size_t lookups = std::min<size_t>(entries, size_t(1) << 22);
+
+    long faults_before = page_faults();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < entries; ++i) {
+        insert_latency.run(i, [&]() { insert(table, stream.key(i)); });
+    }
+    std::chrono::duration<double> insert_time = std::chrono::high_resolution_clock::now() - start;
+    long faults = page_faults() - faults_before;
+
+    std::mt19937_64 rand_engine(7);
+    std::uniform_int_distribution<uint64_t> unif(0, entries - 1);
+    ZipfSampler zipf(entries, 0.99);
+    size_t hits = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        uint64_t rank = distribution == KeyDistribution::Zipf ? zipf(rand_engine) : unif(rand_engine);
+        int key = stream.key(rank);
+        hit_latency.run(i, [&]() { hits += contains(table, key); });
+    }
+    std::chrono::duration<double> lookup_time = std::chrono::high_resolution_clock::now() - start;
+    for (size_t i = 0; i < lookups; ++i) {
+        int key = stream.key(entries + unif(rand_engine));
+        miss_latency.run(i, [&]() { hits += contains(table, key); });
+    }
+
+    size_t stored = table.size();
+    output << engine << "," << distribution_name(distribution) << "," << slots << "," << static_cast<double>(entries) / slots << ","
+           << static_cast<double>(stored) / table.capacity() << "," << static_cast<double>(table.memory_bytes()) / stored << ","
+           << faults << "," << insert_latency.percentile(0.5) << "," << insert_latency.percentile(0.99) << ","
+           << insert_latency.percentile(0.999) << "," << hit_latency.percentile(0.5) << "," << hit_latency.percentile(0.99) << ","
+           << hit_latency.percentile(0.999) << "," << miss_latency.percentile(0.5) << "," << miss_latency.percentile(0.99) << ","
+           << miss_latency.percentile(0.999) << "," << entries / insert_time.count() << "," << lookups / lookup_time.count() << std::endl;
+    std::cout << "  " << engine << " " << distribution_name(distribution) << " slots=" << slots
+              << " load=" << static_cast<double>(entries) / slots << " stored=" << stored << " hits=" << hits << std::endl;
+}
+
+void run_large_sweep(size_t max_bytes, std::ofstream& output) {
+    output << "Engine,Distribution,Slots,LoadFactor,ActualLoad,BytesPerEntry,PageFaults,InsertNsP50,InsertNsP99,InsertNsP999,"
+              "HitNsP50,HitNsP99,HitNsP999,MissNsP50,MissNsP99,MissNsP999,InsertOpsPerSec,HitOpsPerSec\n";
+
+    double load_factors[] = {0.5, 0.7, 0.8, 0.9, 0.95};
+    KeyDistribution distributions[] = {KeyDistribution::Uniform, KeyDistribution::Zipf,
+                                       KeyDistribution::Sequential, KeyDistribution::Clustered};
+
+    for (size_t slots = size_t(1) << 16; slots * 8 <= max_bytes && slots <= (size_t(1) << 32); slots *= 4) {
+        std::cout << "Sweep: " << slots << " slots" << std::endl;
+        for (double load_factor : load_factors) {
+            size_t entries = static_cast<size_t>(slots * load_factor);
+            for (KeyDistribution distribution : distributions) {
+                {
+                    HashTable<> table(slots);
+                    run_sweep_cell("Linear", table, [](HashTable<>& t, int key) { t.linear_insert(key); },
+                                   [](const HashTable<>& t, int key) { return t.contains<LinearProbe>(key); },
+                                   slots, entries, distribution, output);
+                }
+                {
+                    HashTable<> table(slots);
+                    run_sweep_cell("RobinHood", table, [](HashTable<>& t, int key) { t.robin_hood_insert(key); },
+                                   [](const HashTable<>& t, int key) { return t.contains<RobinHoodProbe>(key); },
+                                   slots, entries, distribution, output);
+                }
+                {
+                    HashTable<> table(slots);
+                    run_sweep_cell("Quadratic", table, [](HashTable<>& t, int key) { t.quadratic_insert(key); },
+                                   [](const HashTable<>& t, int key) { return t.contains<QuadraticProbe>(key); },
+                                   slots, entries, distribution, output);
+                }
+                {
+                    SwissTable<int, bool> table(slots / 8 * 7);
+                    run_sweep_cell("Swiss", table, [](SwissTable<int, bool>& t, int key) { t.insert(key, true); },
+                                   [](const SwissTable<int, bool>& t, int key) { return t.contains(key); },
+                                   slots, entries, distribution, output);
+                }
+                {
+                    CompactHashSet<int> table(slots, 0.95);
+                    run_sweep_cell("Compact", table, [](CompactHashSet<int>& t, int key) { t.insert(key); },
+                                   [](const CompactHashSet<int>& t, int key) { return t.contains(key); },
+                                   slots, entries, distribution, output);
+                }
+                {
+                    CuckooTable<int, bool> table(slots * 9 / 10);
+                    run_sweep_cell("Cuckoo", table, [](CuckooTable<int, bool>& t, int key) { t.insert(key, true); },
+                                   [](const CuckooTable<int, bool>& t, int key) { return t.contains(key); },
+                                   slots, entries, distribution, output);
+                }
+            }
+        }
+    }
+}
+
+std::string results_header() {
+    std::ostringstream output;
+    output << "Size,FillFactor,CubicTime,QuadraticTime,CubicClusters,QuadraticClusters,CubicCollisions,QuadraticCollisions,SwissTime";
+    for (const char* scheme : {"Linear", "RobinHood"}) {
+        output << "," << scheme << "Time," << scheme << "Clusters," << scheme << "Collisions";
+    }
+    for (const char* scheme : {"Cubic", "Quadratic", "Linear", "RobinHood"}) {
+        output << "," << scheme << "MaxPSL," << scheme << "P99PSL," << scheme << "AvgHit," << scheme << "AvgMiss";
+    }
+    output << ",CuckooTime";
+    for (const char* scheme : {"Cubic", "Quadratic", "Linear", "RobinHood", "Swiss", "Cuckoo"}) {
+        output << "," << scheme << "LookupTime";
+    }
+    output << ",CompactTime,CompactLookupTime";
+    for (const char* scheme : {"Cubic", "Quadratic", "Linear", "RobinHood", "Swiss", "Cuckoo", "Compact"}) {
+        output << "," << scheme << "BytesPerKey";
+    }
+    output << "\n";
+    return output.str();
+}
+
+// The size x fill factor grid of test_hashing as sweep cells. Writes results.csv and
+// psl_histogram.csv in the same format as the serial run; each cell's console report goes to
+// std::cout in grid order.
+void run_hashing_sweep(const std::string& journal_path, const std::vector<size_t>& test_sizes,
+                       const std::vector<double>& fill_factors, int iterations) {
+    SweepRunner runner(journal_path, 3);
+    runner.text(results_header(), 0);
+    runner.text("Size,FillFactor,Scheme,PSL,Count\n", 1);
+    for (size_t size : test_sizes) {
+        for (double fill_factor : fill_factors) {
+            std::string key = std::to_string(size) + " " + std::to_string(fill_factor) + " " + std::to_string(iterations);
+            runner.add(key, [=](SweepRunner::Output& out) {
+                test_hashing(size, fill_factor, iterations, out[0], out[1], out[2]);
+            });
+        }
+    }
+    std::ofstream output("results.csv");
+    std::ofstream histogram_output("psl_histogram.csv");
+    runner.run({&output, &histogram_output, &std::cout});
+    std::cout << "Sweep: " << runner.ran() << " cells run, " << runner.reused() << " reused from " << journal_path << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t test_sizes[] = {23, 101, 503, 1009};  
+    double fill_factors[] = {0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 0.95}; 
+    int iterations = 30;  
+
+    // ./A2 sweep [journal] runs only the results.csv / psl_histogram.csv grid, in parallel and
+    // resumable; the concurrency and batch benchmarks use every core themselves.
+    if (argc > 1 && std::string(argv[1]) == "sweep") {
+        run_hashing_sweep(argc > 2 ? argv[2] : "hashing-sweep.journal",
+                          std::vector<size_t>(std::begin(test_sizes), std::end(test_sizes)),
+                          std::vector<double>(std::begin(fill_factors), std::end(fill_factors)), iterations);
+        return 0;
+    }
+
+    // ./A2 check runs the regression checks and fails if any of them does.
+    if (argc > 1 && std::string(argv[1]) == "check") {
+        bool ok = check_swiss_high_bit_keys(std::cout);
+        ok = check_concurrent_root(std::cout) && ok;
+        return ok ? 0 : 1;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "large") {
+        double max_gb = argc > 2 ? std::stod(argv[2]) : 4.0;
+        std::ofstream sweep_output("sweep_results.csv");
+        run_large_sweep(static_cast<size_t>(max_gb * (1ull << 30)), sweep_output);
+        sweep_output.close();
+        return 0;
+    }
+
+    std::ofstream output("results.csv");
+    output << results_header();
+
+    std::ofstream histogram_output("psl_histogram.csv");
+    histogram_output << "Size,FillFactor,Scheme,PSL,Count\n";
+
+    for (size_t size : test_sizes) {
+        for (double fill_factor : fill_factors) {
+            test_hashing(size, fill_factor, iterations, output, histogram_output);
+        }
+    }
+
+    output.close();
+    histogram_output.close();
+
+    std::ofstream concurrent_output("concurrent_results.csv");
+    concurrent_output << "Threads,OpsPerSec,Speedup,Collisions,Capacity\n";
+    int max_threads = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    test_concurrent_hashing(4000000, max_threads, concurrent_output);
+    concurrent_output.close();
+
+    std::ofstream batch_output("batch_results.csv");
+    batch_output << "Keys,ScalarInsertOpsPerSec,BatchInsertOpsPerSec,ScalarLookupOpsPerSec,BatchLookupOpsPerSec\n";
+    for (size_t key_count : {size_t(1) << 16, size_t(1) << 20, size_t(1) << 23}) {
+        test_batched_hashing(key_count, batch_output);
+    }
+    batch_output.close();
+    return 0;
+}
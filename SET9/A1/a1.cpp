@@ -1,14 +1,26 @@
 #include <iostream>
 #include <vector>
+#include <tuple>
 #include <string>
 #include <algorithm>
 #include <fstream>
 #include <chrono>
 #include <array>
+#include <memory>
+#include <cstdint>
+#include <iterator>
+#include <sys/resource.h>
+
+#include "../../common/argsort.h"
+#include "../../common/datasetCache.h"
+#include "../../common/frontCoding.h"
+#include "../../common/sweepRunner.h"
 
 const std::string UNSORTED = "unsorted";
 const std::string REVERSED = "reversed";
 const std::string ALMOST_SORTED = "almost-sorted";
+const std::string URLS = "urls";
+const std::string PATHS = "paths";
 
 class TestDataHelper {
 public:
@@ -37,19 +49,166 @@ public:
         file.close();
         return strings;
     }
+
+    // The whole file as one blob, for builders that index text rather than sort lines.
+    std::string readTextFromFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error opening file: " << filename << std::endl;
+            return "";
+        }
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Prefers the mapped string table that stringGenerator writes next to each text file.
+    std::vector<std::string> readStrings(const std::string& filename) {
+        MappedDataset dataset;
+        if (!dataset.open(filename + ".bin") || dataset.header().elementType != DatasetHeader::StringTable) {
+            return readStringsFromFile(filename);
+        }
+        std::vector<std::string> strings;
+        strings.reserve(dataset.size());
+        for (size_t i = 0; i < dataset.size(); ++i) {
+            strings.emplace_back(dataset.string(i));
+        }
+        return strings;
+    }
+};
+
+struct OperationStats {
+    uint64_t charInspections = 0;
+    uint64_t comparisons = 0;
+    uint64_t moves = 0;
+    uint64_t allocations = 0;
+};
+
+struct NoCounting {
+    static constexpr bool enabled = false;
+
+    static void inspect(uint64_t = 1) {}
+    static void compare() {}
+    static void move(uint64_t = 1) {}
+    static void allocate(uint64_t = 1) {}
+};
+
+struct Counting {
+    static constexpr bool enabled = true;
+
+    static OperationStats& stats() {
+        thread_local OperationStats counters;
+        return counters;
+    }
+
+    static void reset() {
+        stats() = OperationStats();
+    }
+
+    static void inspect(uint64_t n = 1) { stats().charInspections += n; }
+    static void compare() { ++stats().comparisons; }
+    static void move(uint64_t n = 1) { stats().moves += n; }
+    static void allocate(uint64_t n = 1) { stats().allocations += n; }
+};
+
+template <typename Stats>
+bool lessCounted(const std::string& a, const std::string& b) {
+    if constexpr (Stats::enabled) {
+        Stats::compare();
+        size_t n = std::min(a.size(), b.size());
+        size_t i = 0;
+        while (i < n && a[i] == b[i]) ++i;
+        Stats::inspect(i < n ? i + 1 : i);
+        return i < n ? static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]) : a.size() < b.size();
+    } else {
+        return a < b;
+    }
+}
+
+template <typename Stats, typename T>
+void pushCounted(std::vector<T>& v, const T& value) {
+    if constexpr (Stats::enabled) {
+        if (v.size() == v.capacity()) Stats::allocate();
+        Stats::move();
+    }
+    v.push_back(value);
+}
+
+// Distinct mode output: every key once, ascending, with the number of times it occurred.
+// Each engine's sortDistinct finds the groups during the sort itself and may leave array in
+// any order; sort keeps every duplicate and stays the default.
+struct KeyCount {
+    std::string key;
+    uint64_t count;
 };
 
+enum class OutputMode { All, Distinct };
+
+// Key+index mode: an engine sorts pointers to the strings, so its buckets and copies move
+// 8-byte handles instead of whole strings. The sorted handles give the order, and
+// applyPermutation then moves every string once into place.
+inline std::vector<const std::string*> handlesOf(const std::vector<std::string>& array) {
+    std::vector<const std::string*> handles(array.size());
+    for (size_t i = 0; i < array.size(); ++i) {
+        handles[i] = &array[i];
+    }
+    return handles;
+}
+
+inline std::vector<uint32_t> orderOf(const std::vector<std::string>& array, const std::vector<const std::string*>& handles) {
+    std::vector<uint32_t> order(handles.size());
+    for (size_t i = 0; i < handles.size(); ++i) {
+        order[i] = static_cast<uint32_t>(handles[i] - array.data());
+    }
+    return order;
+}
+
+inline const std::string& keyOf(const std::string& s) {
+    return s;
+}
+
+inline const std::string& keyOf(const std::string* s) {
+    return *s;
+}
+
+template <typename Stats = NoCounting>
 class MergeSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& array) {
-        compareCount = 0;
         if (array.size() < 2) return;
         mergeSort(array, 0, array.size() - 1);
     }
 
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        if (array.empty()) return {};
+        return mergeSortDistinct(array, 0, array.size() - 1);
+    }
+
 private:
+    // Equal heads are folded into one group instead of being emitted one after the other.
+    static std::vector<KeyCount> mergeSortDistinct(const std::vector<std::string>& array, int left, int right) {
+        if (left == right) return {{array[left], 1}};
+        int mid = left + (right - left) / 2;
+        std::vector<KeyCount> P = mergeSortDistinct(array, left, mid);
+        std::vector<KeyCount> Q = mergeSortDistinct(array, mid + 1, right);
+        std::vector<KeyCount> R;
+        Stats::allocate();
+        size_t i = 0, j = 0;
+        while (i < P.size() && j < Q.size()) {
+            if (lessCounted<Stats>(P[i].key, Q[j].key)) {
+                R.push_back(std::move(P[i++]));
+            } else if (lessCounted<Stats>(Q[j].key, P[i].key)) {
+                R.push_back(std::move(Q[j++]));
+            } else {
+                P[i].count += Q[j++].count;
+                R.push_back(std::move(P[i++]));
+            }
+            Stats::move();
+        }
+        Stats::move(P.size() - i + Q.size() - j);
+        std::move(P.begin() + i, P.end(), std::back_inserter(R));
+        std::move(Q.begin() + j, Q.end(), std::back_inserter(R));
+        return R;
+    }
+
     static void mergeSort(std::vector<std::string>& array, int left, int right) {
         if (left >= right) return;
         int mid = left + (right - left) / 2;
@@ -60,11 +219,11 @@ private:
 
     static void merge(std::vector<std::string>& array, int left, int mid, int right) {
         std::vector<std::string> temp(right - left + 1);
+        Stats::allocate();
         int i = left, j = mid + 1, k = 0;
 
         while (i <= mid && j <= right) {
-            compareCount += std::min(array[i].size(), array[j].size());
-            if (array[i] <= array[j]) {
+            if (!lessCounted<Stats>(array[j], array[i])) {
                 temp[k++] = array[i++];
             } else {
                 temp[k++] = array[j++];
@@ -81,19 +240,46 @@ private:
         for (i = left, k = 0; i <= right; i++, k++) {
             array[i] = temp[k];
         }
+        Stats::move(2 * (right - left + 1));
     }
 };
 
+template <typename Stats = NoCounting>
 class QuickSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& array) {
-        compareCount = 0;
         quickSort(array, 0, array.size() - 1);
     }
 
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        std::vector<KeyCount> groups;
+        quickSortDistinct(array, 0, array.size() - 1, groups);
+        return groups;
+    }
+
 private:
+    // Three-way (Dijkstra) partition: the run equal to the pivot is a finished group.
+    static void quickSortDistinct(std::vector<std::string>& array, int low, int high, std::vector<KeyCount>& groups) {
+        if (low > high) return;
+        std::string pivot = array[high];
+        Stats::move();
+        int lt = low, i = low, gt = high;
+        while (i <= gt) {
+            if (lessCounted<Stats>(array[i], pivot)) {
+                std::swap(array[lt++], array[i++]);
+                Stats::move(3);
+            } else if (lessCounted<Stats>(pivot, array[i])) {
+                std::swap(array[i], array[gt--]);
+                Stats::move(3);
+            } else {
+                ++i;
+            }
+        }
+        quickSortDistinct(array, low, lt - 1, groups);
+        groups.push_back({pivot, static_cast<uint64_t>(gt - lt + 1)});
+        quickSortDistinct(array, gt + 1, high, groups);
+    }
+
     static void quickSort(std::vector<std::string>& array, int low, int high) {
         if (low < high) {
             int pi = partition(array, low, high);
@@ -104,37 +290,68 @@ private:
 
     static int partition(std::vector<std::string>& array, int low, int high) {
         std::string pivot = array[high];
+        Stats::move();
         int i = low - 1;
 
         for (int j = low; j < high; j++) {
-            compareCount += std::min(array[j].size(), pivot.size());
-            if (array[j] < pivot) {
+            if (lessCounted<Stats>(array[j], pivot)) {
                 i++;
                 std::swap(array[i], array[j]);
+                Stats::move(3);
             }
         }
         std::swap(array[i + 1], array[high]);
+        Stats::move(3);
         return i + 1;
     }
 };
 
+template <typename Stats = NoCounting>
 class StringMergeSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& array) {
-        compareCount = 0;
-        auto sortedPairs = stringMergeSort(array);
-        for (int i = 0; i < array.size(); ++i) {
-            array[i] = sortedPairs[i].first;
+        auto sorted = stringMergeSort<false>(array);
+        for (size_t i = 0; i < array.size(); ++i) {
+            array[i] = std::move(sorted[i].key);
         }
+        Stats::move(array.size());
+    }
+
+    // Also returns lcp[i], the common prefix length of array[i - 1] and array[i], which the
+    // LCP merge leaves in its entries for free.
+    static void sortWithLcp(std::vector<std::string>& array, std::vector<int>& lcp) {
+        auto sorted = stringMergeSort<false>(array);
+        lcp.resize(sorted.size());
+        for (size_t i = 0; i < array.size(); ++i) {
+            array[i] = std::move(sorted[i].key);
+            lcp[i] = sorted[i].lcp;
+        }
+        Stats::move(array.size());
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        auto sorted = stringMergeSort<true>(array);
+        std::vector<KeyCount> groups;
+        groups.reserve(sorted.size());
+        for (auto& entry : sorted) {
+            groups.push_back({std::move(entry.key), entry.count});
+        }
+        Stats::move(groups.size());
+        return groups;
     }
 
 private:
+    // lcp is the common prefix length with the previous string of the same sorted run.
+    struct Entry {
+        std::string key;
+        int lcp;
+        uint64_t count;
+    };
+
     static int lcpCompare(const std::string& a, const std::string& b, int index) {
         int n = std::min(a.size(), b.size());
         for (int i = index; i < n; ++i) {
-            ++compareCount;
+            Stats::inspect();
             if (a[i] != b[i]) {
                 return i;
             }
@@ -142,115 +359,166 @@ private:
         return n;
     }
 
-    static std::vector<std::pair<std::string, int>> stringMerge(const std::vector<std::pair<std::string, int>>& P, const std::vector<std::pair<std::string, int>>& Q) {
-        std::vector<std::pair<std::string, int>> R;
-        int i = 0, j = 0;
+    // LCP merge: both heads carry their LCP with the last string written to R. The head with
+    // the larger LCP is the smaller string; only on a tie are characters compared, starting
+    // past the shared prefix. A comparison that runs off the end of both strings is a full-LCP
+    // hit, i.e. a duplicate: it is kept after P's copy (stable) or folded into it (Distinct),
+    // which is then written at once so both new heads are again relative to it.
+    template <bool Distinct>
+    static std::vector<Entry> stringMerge(std::vector<Entry>& P, std::vector<Entry>& Q) {
+        std::vector<Entry> R;
+        size_t i = 0, j = 0;
         while (i < P.size() && j < Q.size()) {
-            if (P[i].first < Q[j].first) {
-                compareCount += std::min(P[i].first.size(), Q[j].first.size());
-                R.push_back(P[i++]);
-            } else if (P[i].first > Q[j].first) {
-                compareCount += std::min(P[i].first.size(), Q[j].first.size());
-                R.push_back(Q[j++]);
+            Stats::compare();
+            if (P[i].lcp > Q[j].lcp) {
+                pushCounted<Stats>(R, P[i++]);
+            } else if (P[i].lcp < Q[j].lcp) {
+                pushCounted<Stats>(R, Q[j++]);
             } else {
-                int lcp = lcpCompare(P[i].first, Q[j].first, std::max(P[i].second, Q[j].second));
-                if (lcp < P[i].first.size() && lcp < Q[j].first.size()) {
-                    if (P[i].first[lcp] < Q[j].first[lcp]) {
-                        R.push_back({P[i].first, lcp});
-                        i++;
-                    } else {
-                        R.push_back({Q[j].first, lcp});
-                        j++;
-                    }
+                int lcp = lcpCompare(P[i].key, Q[j].key, P[i].lcp);
+                bool pEnds = lcp == static_cast<int>(P[i].key.size()), qEnds = lcp == static_cast<int>(Q[j].key.size());
+                if (pEnds && qEnds && Distinct) {
+                    P[i].count += Q[j++].count;
+                    pushCounted<Stats>(R, P[i++]);
+                } else if (pEnds || (!qEnds && static_cast<unsigned char>(P[i].key[lcp]) < static_cast<unsigned char>(Q[j].key[lcp]))) {
+                    Q[j].lcp = lcp;
+                    pushCounted<Stats>(R, P[i++]);
                 } else {
-                    R.push_back(P[i]);
-                    i++;
-                    j++;
+                    P[i].lcp = lcp;
+                    pushCounted<Stats>(R, Q[j++]);
                 }
             }
         }
-        while (i < P.size()) R.push_back(P[i++]);
-        while (j < Q.size()) R.push_back(Q[j++]);
+        while (i < P.size()) pushCounted<Stats>(R, P[i++]);
+        while (j < Q.size()) pushCounted<Stats>(R, Q[j++]);
         return R;
     }
 
-    static std::vector<std::pair<std::string, int>> stringMergeSort(const std::vector<std::string>& strings) {
+    template <bool Distinct>
+    static std::vector<Entry> stringMergeSort(const std::vector<std::string>& strings) {
         if (strings.size() <= 1) {
             if (!strings.empty()) {
-                return {{strings[0], 0}};
+                return {{strings[0], 0, 1}};
             }
             return {};
         }
         int mid = strings.size() / 2;
         std::vector<std::string> left(strings.begin(), strings.begin() + mid);
         std::vector<std::string> right(strings.begin() + mid, strings.end());
-        auto P = stringMergeSort(left);
-        auto Q = stringMergeSort(right);
-        return stringMerge(P, Q);
+        Stats::allocate(2);
+        Stats::move(strings.size());
+        auto P = stringMergeSort<Distinct>(left);
+        auto Q = stringMergeSort<Distinct>(right);
+        return stringMerge<Distinct>(P, Q);
     }
 };
 
+template <typename Stats = NoCounting>
 class StringQuickSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& strings) {
-        compareCount = 0;
-        stringQuickSort(strings, 0, strings.size(), 0);
+        stringQuickSort(strings, 0, strings.size(), 0, nullptr);
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& strings) {
+        std::vector<KeyCount> groups;
+        stringQuickSort(strings, 0, strings.size(), 0, &groups);
+        return groups;
+    }
+
+    // Sorts strings[start, end) given that they already agree on their first index bytes.
+    template <typename T>
+    static void sortRange(std::vector<T>& strings, int start, int end, int index, std::vector<KeyCount>* groups) {
+        stringQuickSort(strings, start, end, index, groups);
     }
 
 private:
-    static void stringQuickSort(std::vector<std::string>& strings, int start, int end, int index) {
-        if (end - start <= 1) return;
+    // Bytes compare unsigned, like std::string; -1 past the end puts shorter strings first.
+    static int charAt(const std::string& s, int index) {
+        return static_cast<size_t>(index) < s.size() ? static_cast<unsigned char>(s[index]) : -1;
+    }
 
-        if (index >= strings[0].size()) return;
+    // With groups set, ranges are finished in order and appended as (key, count); an equal
+    // partition on the end-of-string marker is a run of identical strings. T is a string or
+    // a pointer to one.
+    template <typename T>
+    static void stringQuickSort(std::vector<T>& strings, int start, int end, int index, std::vector<KeyCount>* groups) {
+        if (end - start <= 1) {
+            if (groups && end - start == 1) groups->push_back({keyOf(strings[start]), 1});
+            return;
+        }
 
         int pivotIndex = start + (end - start) / 2;
-        char pivot = strings[pivotIndex][index];
+        int pivot = charAt(keyOf(strings[pivotIndex]), index);
 
         int less = start;
         int equal = start;
         int greater = end;
 
         while (equal < greater) {
-            compareCount++;
-            if (index < strings[equal].size() && strings[equal][index] < pivot) {
+            Stats::inspect();
+            int c = charAt(keyOf(strings[equal]), index);
+            if (c < pivot) {
                 std::swap(strings[less++], strings[equal++]);
-            } else if (index < strings[equal].size() && strings[equal][index] == pivot) {
+                Stats::move(3);
+            } else if (c == pivot) {
                 ++equal;
             } else {
                 std::swap(strings[equal], strings[--greater]);
+                Stats::move(3);
             }
         }
 
-        stringQuickSort(strings, start, less, index);
-        if (index < strings[0].size()) {
-            stringQuickSort(strings, less, greater, index + 1);
+        stringQuickSort(strings, start, less, index, groups);
+        if (pivot >= 0) {
+            stringQuickSort(strings, less, greater, index + 1, groups);
+        } else if (groups) {
+            groups->push_back({keyOf(strings[less]), static_cast<uint64_t>(greater - less)});
         }
-        stringQuickSort(strings, greater, end, index);
+        stringQuickSort(strings, greater, end, index, groups);
     }
 };
 
+template <typename Stats = NoCounting>
 class MSDRadixSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& array) {
-        compareCount = 0;
         int maxLength = findMaxLength(array);
-        msdRadixSort(array, 0, array.size(), 0, maxLength);
+        msdRadixSort(array, 0, array.size(), 0, maxLength, nullptr);
+    }
+
+    static void sortIndexed(std::vector<std::string>& array) {
+        std::vector<const std::string*> handles = handlesOf(array);
+        Stats::allocate();
+        msdRadixSort(handles, 0, handles.size(), 0, findMaxLength(array), nullptr);
+        applyPermutation(array, orderOf(array, handles));
+        Stats::move(array.size());
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        std::vector<KeyCount> groups;
+        msdRadixSort(array, 0, array.size(), 0, findMaxLength(array), &groups);
+        return groups;
     }
 
 private:
-    static void msdRadixSort(std::vector<std::string>& array, int start, int end, int index, int maxLength) {
-        if (start >= end - 1 || index >= maxLength) return;
+    // Bucket 0 holds the strings that end at index; sharing the prefix, they are all equal.
+    // Byte c goes to bucket c + 1, so a '\0' byte is not mistaken for the end.
+    // T is a string or a pointer to one.
+    template <typename T>
+    static void msdRadixSort(std::vector<T>& array, int start, int end, int index, int maxLength, std::vector<KeyCount>* groups) {
+        if (start >= end - 1 || index >= maxLength) {
+            if (groups && start < end) groups->push_back({keyOf(array[start]), static_cast<uint64_t>(end - start)});
+            return;
+        }
 
-        std::array<std::vector<std::string>, 128> buckets;
+        std::array<std::vector<T>, 129> buckets;
 
         for (int i = start; i < end; i++) {
-            compareCount++;
-            char c = index < array[i].size() ? array[i][index] : 0;
-            buckets[c].push_back(array[i]);
+            Stats::inspect();
+            const std::string& s = keyOf(array[i]);
+            int c = static_cast<size_t>(index) < s.size() ? s[index] + 1 : 0;
+            pushCounted<Stats>(buckets[c], array[i]);
         }
 
         int pos = start;
@@ -258,7 +526,12 @@ private:
             for (auto& s : bucket) {
                 array[pos++] = s;
             }
-            msdRadixSort(array, pos - bucket.size(), pos, index + 1, maxLength);
+            Stats::move(bucket.size());
+            if (&bucket == &buckets[0]) {
+                if (groups && !bucket.empty()) groups->push_back({keyOf(bucket[0]), bucket.size()});
+            } else {
+                msdRadixSort(array, pos - bucket.size(), pos, index + 1, maxLength, groups);
+            }
             bucket.clear();
         }
     }
@@ -274,39 +547,68 @@ private:
     }
 };
 
+template <typename Stats = NoCounting>
 class HybridMSDQuickSort {
 public:
-    static int compareCount;
-
     static void sort(std::vector<std::string>& array) {
-        compareCount = 0;
-        hybridMSDQuickSort(array, 0, array.size(), 0, findMaxLength(array));
+        hybridMSDQuickSort(array, 0, array.size(), 0, findMaxLength(array), nullptr);
+    }
+
+    static void sortIndexed(std::vector<std::string>& array) {
+        std::vector<const std::string*> handles = handlesOf(array);
+        Stats::allocate();
+        hybridMSDQuickSort(handles, 0, handles.size(), 0, findMaxLength(array), nullptr);
+        applyPermutation(array, orderOf(array, handles));
+        Stats::move(array.size());
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        std::vector<KeyCount> groups;
+        hybridMSDQuickSort(array, 0, array.size(), 0, findMaxLength(array), &groups);
+        return groups;
     }
 
 private:
-    static void hybridMSDQuickSort(std::vector<std::string>& array, int start, int end, int index, int maxLength) {
-        if (start >= end - 1 || index >= maxLength) return;
+    // T is a string or a pointer to one.
+    template <typename T>
+    static void hybridMSDQuickSort(std::vector<T>& array, int start, int end, int index, int maxLength, std::vector<KeyCount>* groups) {
+        if (start >= end - 1 || index >= maxLength) {
+            if (groups && start < end) groups->push_back({keyOf(array[start]), static_cast<uint64_t>(end - start)});
+            return;
+        }
 
         if (end - start < 50) {
-            std::vector<std::string> subArray(array.begin() + start, array.begin() + end);
-            StringQuickSort::sort(subArray);
+            std::vector<T> subArray(array.begin() + start, array.begin() + end);
+            Stats::allocate();
+            Stats::move(2 * (end - start));
+            if (groups) {
+                StringQuickSort<Stats>::sortRange(subArray, 0, subArray.size(), 0, groups);
+                return;
+            }
+            StringQuickSort<Stats>::sortRange(subArray, 0, subArray.size(), 0, nullptr);
             std::copy(subArray.begin(), subArray.end(), array.begin() + start);
             return;
         }
 
-        std::array<std::vector<std::string>, 128> buckets;
+        std::array<std::vector<T>, 129> buckets;
         for (int i = start; i < end; i++) {
-            compareCount++;
-            char c = index < array[i].size() ? array[i][index] : 0;
-            buckets[c].push_back(array[i]);
+            Stats::inspect();
+            const std::string& s = keyOf(array[i]);
+            int c = static_cast<size_t>(index) < s.size() ? s[index] + 1 : 0;
+            pushCounted<Stats>(buckets[c], array[i]);
         }
 
         int pos = start;
         for (auto& bucket : buckets) {
             if (!bucket.empty()) {
                 int bucketSize = bucket.size();
-                hybridMSDQuickSort(bucket, 0, bucketSize, index + 1, maxLength);
+                if (&bucket == &buckets[0]) {
+                    if (groups) groups->push_back({keyOf(bucket[0]), bucket.size()});
+                } else {
+                    hybridMSDQuickSort(bucket, 0, bucketSize, index + 1, maxLength, groups);
+                }
                 std::copy(bucket.begin(), bucket.end(), array.begin() + pos);
+                Stats::move(bucketSize);
                 pos += bucketSize;
             }
         }
@@ -323,53 +625,618 @@ private:
     }
 };
 
-int MergeSort::compareCount = 0;
-int QuickSort::compareCount = 0;
-int StringMergeSort::compareCount = 0;
-int StringQuickSort::compareCount = 0;
-int MSDRadixSort::compareCount = 0;
-int HybridMSDQuickSort::compareCount = 0;
+// Key+index mode of the radix engines, in the shape StringSortTester runs.
+template <typename Stats = NoCounting>
+struct IndexedMSDRadixSort {
+    static void sort(std::vector<std::string>& array) {
+        MSDRadixSort<Stats>::sortIndexed(array);
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        return MSDRadixSort<Stats>::sortDistinct(array);
+    }
+};
+
+template <typename Stats = NoCounting>
+struct IndexedHybridMSDQuickSort {
+    static void sort(std::vector<std::string>& array) {
+        HybridMSDQuickSort<Stats>::sortIndexed(array);
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        return HybridMSDQuickSort<Stats>::sortDistinct(array);
+    }
+};
+
+// Burstsort (Sinha and Zobel): string pointers are inserted into a trie whose leaves are
+// small unsorted containers. A container that grows past burstLimit is replaced by a trie
+// node one byte deeper, so every container stays small enough to sort in cache. Traversal
+// visits the trie in byte order and sorts each container with the multikey quicksort,
+// starting past the bytes its path already fixes.
+template <typename Stats = NoCounting>
+class BurstSort {
+public:
+    static constexpr size_t burstLimit = 1024;
+
+    static void sort(std::vector<std::string>& array) {
+        Node root;
+        insertAll(array, root);
+        std::vector<std::string*> order;
+        order.reserve(array.size());
+        traverse(root, 0, order, nullptr);
+
+        std::vector<std::string> sorted;
+        sorted.reserve(array.size());
+        Stats::allocate();
+        for (std::string* s : order) {
+            sorted.push_back(std::move(*s));
+        }
+        Stats::move(array.size());
+        array.swap(sorted);
+    }
+
+    static std::vector<KeyCount> sortDistinct(std::vector<std::string>& array) {
+        Node root;
+        insertAll(array, root);
+        std::vector<std::string*> order;
+        std::vector<KeyCount> groups;
+        traverse(root, 0, order, &groups);
+        return groups;
+    }
+
+private:
+    struct Node {
+        // Strings that end at this node's depth; sharing the path, they are all equal.
+        std::vector<std::string*> ended;
+        std::array<std::unique_ptr<Node>, 256> children;
+        std::array<std::vector<std::string*>, 256> buckets;
+    };
+
+    static void insertAll(std::vector<std::string>& array, Node& root) {
+        for (std::string& s : array) {
+            insert(root, &s, 0);
+        }
+    }
+
+    static void insert(Node& root, std::string* s, int depth) {
+        Node* node = &root;
+        while (true) {
+            if (static_cast<size_t>(depth) == s->size()) {
+                pushCounted<Stats>(node->ended, s);
+                return;
+            }
+            Stats::inspect();
+            unsigned char c = (*s)[depth];
+            if (node->children[c]) {
+                node = node->children[c].get();
+                ++depth;
+                continue;
+            }
+            std::vector<std::string*>& bucket = node->buckets[c];
+            pushCounted<Stats>(bucket, s);
+            if (bucket.size() > burstLimit) {
+                burst(*node, c, depth + 1);
+            }
+            return;
+        }
+    }
+
+    static void burst(Node& node, unsigned char c, int depth) {
+        std::vector<std::string*> bucket;
+        bucket.swap(node.buckets[c]);
+        node.children[c] = std::make_unique<Node>();
+        Stats::allocate();
+        for (std::string* s : bucket) {
+            insert(*node.children[c], s, depth);
+        }
+    }
+
+    static void traverse(Node& node, int depth, std::vector<std::string*>& order, std::vector<KeyCount>* groups) {
+        if (!node.ended.empty()) {
+            if (groups) {
+                groups->push_back({*node.ended[0], node.ended.size()});
+            } else {
+                order.insert(order.end(), node.ended.begin(), node.ended.end());
+            }
+        }
+        for (int c = 0; c < 256; ++c) {
+            if (node.children[c]) {
+                traverse(*node.children[c], depth + 1, order, groups);
+                continue;
+            }
+            std::vector<std::string*>& bucket = node.buckets[c];
+            if (bucket.empty()) continue;
+            StringQuickSort<Stats>::sortRange(bucket, 0, bucket.size(), depth + 1, groups);
+            if (!groups) {
+                order.insert(order.end(), bucket.begin(), bucket.end());
+            }
+        }
+    }
+};
+
+// Manber-Myers prefix doubling: after round k suffixes are ranked by their first 2^k bytes.
+// Each round is an LSD radix sort of (rank[i], rank[i + k]) pairs; the second key comes for
+// free from the previous order, so only one counting pass over the first key is needed.
+// O(n log n), but with small constants for moderate inputs.
+// The string engines are not used here: they would sort suffixes as strings, which means
+// O(n^2) bytes for the MSDRadixSort buckets. After the first round every suffix is one integer
+// rank, and a counting pass is the radix step those engines would do on it.
+class PrefixDoublingSuffixArray {
+public:
+    static std::vector<int> build(const std::string& text) {
+        int n = text.size();
+        std::vector<int> sa(n), rank(n), order(n), count(std::max(256, n) + 1);
+        for (int i = 0; i < n; ++i) {
+            rank[i] = static_cast<unsigned char>(text[i]);
+            ++count[rank[i] + 1];
+        }
+        countingSort(rank, count, [](int i) { return i; }, sa, n);
+
+        for (int k = 1; k < n; k <<= 1) {
+            int p = 0;
+            for (int i = n - k; i < n; ++i) {
+                order[p++] = i;
+            }
+            for (int i = 0; i < n; ++i) {
+                if (sa[i] >= k) {
+                    order[p++] = sa[i] - k;
+                }
+            }
+            std::fill(count.begin(), count.end(), 0);
+            for (int i = 0; i < n; ++i) {
+                ++count[rank[i] + 1];
+            }
+            countingSort(rank, count, [&](int i) { return order[i]; }, sa, n);
+
+            std::vector<int>& next = order;
+            next[sa[0]] = 0;
+            for (int i = 1; i < n; ++i) {
+                int a = sa[i - 1], b = sa[i];
+                bool same = rank[a] == rank[b] && (a + k < n ? rank[a + k] : -1) == (b + k < n ? rank[b + k] : -1);
+                next[b] = next[a] + (same ? 0 : 1);
+            }
+            std::swap(rank, next);
+            if (rank[sa[n - 1]] == n - 1) {
+                break;
+            }
+        }
+        return sa;
+    }
+
+private:
+    // Stable scatter of the elements produced by at(0..n) by their rank; count holds the
+    // histogram shifted by one.
+    template <typename At>
+    static void countingSort(const std::vector<int>& rank, std::vector<int>& count, At at, std::vector<int>& sa, int n) {
+        for (size_t c = 1; c < count.size(); ++c) {
+            count[c] += count[c - 1];
+        }
+        for (int i = 0; i < n; ++i) {
+            int suffix = at(i);
+            sa[count[rank[suffix]]++] = suffix;
+        }
+    }
+};
+
+// SA-IS (Nong, Zhang and Chan): classify suffixes as S or L type, sort the LMS substrings by
+// induced sorting, recurse on their names if they are not unique, then induce the full order
+// from the sorted LMS suffixes. Linear time, and about 5n bytes beyond the text at the top
+// level.
+class SAISSuffixArray {
+public:
+    static std::vector<int> build(const std::string& text) {
+        int n = text.size();
+        std::vector<uint16_t> s(n + 1);
+        for (int i = 0; i < n; ++i) {
+            s[i] = static_cast<unsigned char>(text[i]) + 1;
+        }
+        s[n] = 0;
+        std::vector<int> sa(n + 1);
+        sais(s.data(), sa.data(), n + 1, 256);
+        return std::vector<int>(sa.begin() + 1, sa.end());
+    }
+
+private:
+    // s[n - 1] must be a unique smallest symbol; symbols are in [0, K].
+    template <typename Symbol>
+    static void sais(const Symbol* s, int* sa, int n, int K) {
+        std::vector<char> sType(n);
+        sType[n - 1] = 1;
+        for (int i = n - 2; i >= 0; --i) {
+            sType[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && sType[i + 1]);
+        }
+        auto isLMS = [&](int i) { return i > 0 && sType[i] && !sType[i - 1]; };
+        std::vector<int> bucket(K + 1);
+
+        getBuckets(s, n, bucket, true);
+        std::fill(sa, sa + n, -1);
+        for (int i = 1; i < n; ++i) {
+            if (isLMS(i)) {
+                sa[--bucket[s[i]]] = i;
+            }
+        }
+        induce(s, sa, n, sType, bucket);
+
+        int n1 = 0;
+        for (int i = 0; i < n; ++i) {
+            if (isLMS(sa[i])) {
+                sa[n1++] = sa[i];
+            }
+        }
+        std::fill(sa + n1, sa + n, -1);
+        int name = 0, prev = -1;
+        for (int i = 0; i < n1; ++i) {
+            int pos = sa[i];
+            bool differs = false;
+            for (int d = 0; d < n; ++d) {
+                if (prev == -1 || s[pos + d] != s[prev + d] || sType[pos + d] != sType[prev + d]) {
+                    differs = true;
+                    break;
+                }
+                if (d > 0 && (isLMS(pos + d) || isLMS(prev + d))) {
+                    break;
+                }
+            }
+            if (differs) {
+                ++name;
+                prev = pos;
+            }
+            sa[n1 + pos / 2] = name - 1;
+        }
+        for (int i = n - 1, j = n - 1; i >= n1; --i) {
+            if (sa[i] >= 0) {
+                sa[j--] = sa[i];
+            }
+        }
+
+        int* s1 = sa + n - n1;
+        if (name < n1) {
+            sais(s1, sa, n1, name - 1);
+        } else {
+            for (int i = 0; i < n1; ++i) {
+                sa[s1[i]] = i;
+            }
+        }
+
+        getBuckets(s, n, bucket, true);
+        for (int i = 1, j = 0; i < n; ++i) {
+            if (isLMS(i)) {
+                s1[j++] = i;
+            }
+        }
+        for (int i = 0; i < n1; ++i) {
+            sa[i] = s1[sa[i]];
+        }
+        std::fill(sa + n1, sa + n, -1);
+        for (int i = n1 - 1; i >= 0; --i) {
+            int j = sa[i];
+            sa[i] = -1;
+            sa[--bucket[s[j]]] = j;
+        }
+        induce(s, sa, n, sType, bucket);
+    }
+
+    template <typename Symbol>
+    static void getBuckets(const Symbol* s, int n, std::vector<int>& bucket, bool end) {
+        std::fill(bucket.begin(), bucket.end(), 0);
+        for (int i = 0; i < n; ++i) {
+            ++bucket[s[i]];
+        }
+        int sum = 0;
+        for (int& b : bucket) {
+            sum += b;
+            b = end ? sum : sum - b;
+        }
+    }
+
+    // L-type suffixes are placed left to right from bucket heads, then S-type suffixes right
+    // to left from bucket tails.
+    template <typename Symbol>
+    static void induce(const Symbol* s, int* sa, int n, const std::vector<char>& sType, std::vector<int>& bucket) {
+        getBuckets(s, n, bucket, false);
+        for (int i = 0; i < n; ++i) {
+            int j = sa[i] - 1;
+            if (sa[i] > 0 && !sType[j]) {
+                sa[bucket[s[j]]++] = j;
+            }
+        }
+        getBuckets(s, n, bucket, true);
+        for (int i = n - 1; i >= 0; --i) {
+            int j = sa[i] - 1;
+            if (sa[i] > 0 && sType[j]) {
+                sa[--bucket[s[j]]] = j;
+            }
+        }
+    }
+};
+
+// Doubling wins on small and moderate texts, SA-IS once its linear bound pays for the extra
+// passes.
+class SuffixArray {
+public:
+    static constexpr size_t doublingLimit = 1 << 16;
+
+    static std::vector<int> build(const std::string& text) {
+        if (text.size() <= doublingLimit) {
+            return PrefixDoublingSuffixArray::build(text);
+        }
+        return SAISSuffixArray::build(text);
+    }
+};
+
+// Kasai et al.: lcp[i] is the longest common prefix of suffixes sa[i - 1] and sa[i]. Walking
+// suffixes in text order, the LCP drops by at most one per step, so the scan is O(n).
+std::vector<int> kasaiLCP(const std::string& text, const std::vector<int>& sa) {
+    int n = text.size();
+    std::vector<int> rank(n), lcp(n, 0);
+    for (int i = 0; i < n; ++i) {
+        rank[sa[i]] = i;
+    }
+    int h = 0;
+    for (int i = 0; i < n; ++i) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        int j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) {
+            ++h;
+        }
+        lcp[rank[i]] = h;
+        if (h > 0) {
+            --h;
+        }
+    }
+    return lcp;
+}
+
+// Linux keeps the peak resident set in VmHWM and resets it when 5 is written to clear_refs,
+// so every build reports its own peak. Elsewhere the lifetime peak from getrusage is used.
+void resetPeakMemory() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+long peakMemoryKB() {
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            long kb = 0;
+            status >> kb;
+            return kb;
+        }
+    }
+    // ru_maxrss is in kilobytes on Linux but in bytes on macOS.
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+class SuffixArrayTester {
+public:
+    SuffixArrayTester(const std::string& text, const std::string& dataType) : text_(text), dataType_(dataType) {}
+
+    // Prints: bytes, build seconds, MB/s, LCP seconds, peak resident KB.
+    template <typename Builder>
+    void testBuilder(const std::string& builderName) {
+        std::cout << builderName << " | " << dataType_ << std::endl;
+        resetPeakMemory();
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<int> sa = Builder::build(text_);
+        double buildSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<int> lcp = kasaiLCP(text_, sa);
+        double lcpSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        double megabytes = text_.size() / (1024.0 * 1024.0);
+        std::cout << text_.size() << " " << buildSeconds << " " << (buildSeconds > 0 ? megabytes / buildSeconds : 0)
+                  << " " << lcpSeconds << " " << peakMemoryKB() << std::endl;
+        std::cout << std::endl;
+    }
+
+private:
+    std::string text_;
+    std::string dataType_;
+};
 
 class StringSortTester {
 public:
     StringSortTester(const std::vector<std::string>& sourceArray, const std::string& dataType)
         : sourceArray_(sourceArray), dataType_(dataType) {}
 
-    template<typename SortClass>
-    void testAlgorithm(const std::string& algorithmName) {
-        TestDataHelper helper;
+    const std::string& dataType() const {
+        return dataType_;
+    }
+
+    template<template<typename> class SortClass>
+    void testAlgorithm(const std::string& algorithmName, OutputMode mode = OutputMode::All) {
         std::cout << algorithmName << " | " << dataType_ << std::endl;
         for (int n = 100; n <= 3000; n += 100) {
-            std::vector<std::string> array = helper.getPartOfArray(sourceArray_, n);
-            double totalMilliseconds = 0;
-            int totalCompareCount = 0;
-            for (int i = 0; i < 5; ++i) {
-                std::vector<std::string> copiedArray(n);
-                std::copy(array.begin(), array.end(), copiedArray.begin());
-                auto start = std::chrono::high_resolution_clock::now();
-                SortClass::sort(copiedArray);
-                auto elapsed = std::chrono::high_resolution_clock::now() - start;
-                totalMilliseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
-                totalCompareCount += SortClass::compareCount;
-            }
-            double avgTime = totalMilliseconds / 5.0;
-            int avgCompare = totalCompareCount / 5;
-            std::cout << avgTime << " " << avgCompare << std::endl;
+            testSize<SortClass>(n, mode, std::cout, ' ');
         }
         std::cout << std::endl;
     }
 
+    // One row of testAlgorithm: average time, char inspections, comparisons, moves, allocations.
+    template<template<typename> class SortClass>
+    void testSize(int n, OutputMode mode, std::ostream& out, char separator) const {
+        TestDataHelper helper;
+        std::vector<std::string> array = helper.getPartOfArray(sourceArray_, n);
+        double totalMilliseconds = 0;
+        for (int i = 0; i < 5; ++i) {
+            std::vector<std::string> copiedArray(n);
+            std::copy(array.begin(), array.end(), copiedArray.begin());
+            auto start = std::chrono::high_resolution_clock::now();
+            run<SortClass<NoCounting>>(copiedArray, mode);
+            auto elapsed = std::chrono::high_resolution_clock::now() - start;
+            totalMilliseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        }
+        double avgTime = totalMilliseconds / 5.0;
+
+        std::vector<std::string> countedArray = array;
+        Counting::reset();
+        run<SortClass<Counting>>(countedArray, mode);
+        const OperationStats& stats = Counting::stats();
+        out << avgTime << separator << stats.charInspections << separator << stats.comparisons << separator
+            << stats.moves << separator << stats.allocations << std::endl;
+    }
+
 private:
+    template <typename Sorter>
+    static void run(std::vector<std::string>& array, OutputMode mode) {
+        if (mode == OutputMode::Distinct) {
+            Sorter::sortDistinct(array);
+        } else {
+            Sorter::sort(array);
+        }
+    }
+
     std::vector<std::string> sourceArray_;
     std::string dataType_;
 };
 
-int main() {
+// Sorts strings and front codes them with restartInterval keys per block.
+std::string frontCode(std::vector<std::string> strings, uint32_t restartInterval) {
+    std::vector<int> lcp;
+    StringMergeSort<>::sortWithLcp(strings, lcp);
+    FrontCodedWriter writer(restartInterval);
+    for (size_t i = 0; i < strings.size(); ++i) {
+        writer.add(strings[i], lcp[i]);
+    }
+    return writer.finish();
+}
+
+// Prints: restart interval, raw bytes (one key per line), front-coded bytes, ratio.
+void testFrontCoding(const std::vector<std::string>& strings, const std::string& dataType) {
+    size_t rawBytes = 0;
+    for (const auto& s : strings) {
+        rawBytes += s.size() + 1;
+    }
+    std::cout << "Front Coding | " << dataType << std::endl;
+    for (uint32_t restartInterval : {4, 16, 64}) {
+        std::string image = frontCode(strings, restartInterval);
+        std::cout << restartInterval << " " << rawBytes << " " << image.size() << " "
+                  << static_cast<double>(image.size()) / std::max<size_t>(rawBytes, 1) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// The StringSortTester grid as sweep cells, one per (algorithm, input, size), written as rows
+// of algorithm;input;size followed by the testSize columns. Counting keeps its counters per
+// thread, so cells can run side by side.
+void runSweep(const std::string& journalPath, const std::string& outputPath) {
+    using SizeTest = std::function<void(const StringSortTester&, int, OutputMode, std::ostream&)>;
+    std::vector<std::pair<std::string, SizeTest>> algorithms = {
+        {"Merge", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<MergeSort>(n, m, out, ';'); }},
+        {"Quick", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<QuickSort>(n, m, out, ';'); }},
+        {"String Merge", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<StringMergeSort>(n, m, out, ';'); }},
+        {"String Quick", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<StringQuickSort>(n, m, out, ';'); }},
+        {"Radix", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<MSDRadixSort>(n, m, out, ';'); }},
+        {"Hybrid", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<HybridMSDQuickSort>(n, m, out, ';'); }},
+        {"Burst", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<BurstSort>(n, m, out, ';'); }},
+    };
+    // Key+index mode only changes how sort moves strings, so these have no distinct runs.
+    std::vector<std::pair<std::string, SizeTest>> indexedAlgorithms = {
+        {"Radix Indexed", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<IndexedMSDRadixSort>(n, m, out, ';'); }},
+        {"Hybrid Indexed", [](const StringSortTester& t, int n, OutputMode m, std::ostream& out) { t.testSize<IndexedHybridMSDQuickSort>(n, m, out, ';'); }},
+    };
+
+    // The generated inputs are sorted whole; the url and path sets also get the distinct runs.
+    // Inputs too short for the largest size are left out.
+    TestDataHelper testDataHelper;
+    std::vector<std::tuple<std::string, std::string, std::vector<OutputMode>>> sources = {
+        {UNSORTED, "Unsorted", {OutputMode::All}},
+        {REVERSED, "Reversed", {OutputMode::All}},
+        {ALMOST_SORTED, "Almost Sorted", {OutputMode::All}},
+        {URLS, URLS, {OutputMode::All, OutputMode::Distinct}},
+        {PATHS, PATHS, {OutputMode::All, OutputMode::Distinct}},
+    };
+    std::vector<std::pair<StringSortTester, std::vector<OutputMode>>> inputs;
+    for (const auto& [filename, dataType, modes] : sources) {
+        std::vector<std::string> sourceArray = testDataHelper.readStrings(filename);
+        if (sourceArray.size() >= 3000) {
+            inputs.push_back({StringSortTester(sourceArray, dataType), modes});
+        }
+    }
+
+    SweepRunner runner(journalPath);
+    runner.text("Algorithm;Input;Size;Time (us);Char inspections;Comparisons;Moves;Allocations\n");
+    for (const auto& [input, modes] : inputs) {
+        for (OutputMode mode : modes) {
+            std::vector<std::pair<std::string, SizeTest>> tests = algorithms;
+            if (mode == OutputMode::All) {
+                tests.insert(tests.end(), indexedAlgorithms.begin(), indexedAlgorithms.end());
+            }
+            for (const auto& [algorithm, test] : tests) {
+                std::string name = algorithm + (mode == OutputMode::Distinct ? " Distinct" : "");
+                for (int n = 100; n <= 3000; n += 100) {
+                    runner.add(name + " " + input.dataType() + " " + std::to_string(n),
+                               [&input = input, test = test, name, mode, n](SweepRunner::Output& out) {
+                                   out[0] << name << ';' << input.dataType() << ';' << n << ';';
+                                   test(input, n, mode, out[0]);
+                               });
+                }
+            }
+        }
+    }
+    std::ofstream output(outputPath);
+    runner.run({&output});
+    std::cout << "Sweep: " << runner.ran() << " cells run, " << runner.reused() << " reused from " << journalPath << std::endl;
+}
+
+void testSuffixArrays(const std::string& text, const std::string& dataType) {
+    SuffixArrayTester tester(text, dataType);
+    if (text.size() <= 4 * SuffixArray::doublingLimit) {
+        tester.testBuilder<PrefixDoublingSuffixArray>("Suffix Doubling");
+    }
+    tester.testBuilder<SAISSuffixArray>("Suffix SA-IS");
+    tester.testBuilder<SuffixArray>("Suffix Auto");
+}
+
+int main(int argc, char* argv[]) {
     TestDataHelper testDataHelper;
 
-    std::vector<std::string> unsortedSourceArray = testDataHelper.readStringsFromFile(UNSORTED);
-    std::vector<std::string> reversedSourceArray = testDataHelper.readStringsFromFile(REVERSED);
-    std::vector<std::string> almostSortedSourceArray = testDataHelper.readStringsFromFile(ALMOST_SORTED);
+    // ./a1 front <input> <output> [restart interval]
+    if (argc > 3 && std::string(argv[1]) == "front") {
+        std::string image = frontCode(testDataHelper.readStrings(argv[2]), argc > 4 ? std::stoi(argv[4]) : 16);
+        std::ofstream(argv[3], std::ios::binary).write(image.data(), image.size());
+        return 0;
+    }
+
+    // ./a1 lookup <front-coded file> <keys...> prints each key's index, or -1.
+    if (argc > 2 && std::string(argv[1]) == "lookup") {
+        FrontCodedReader reader;
+        if (!reader.open(argv[2])) {
+            std::cerr << "Not a front-coded file: " << argv[2] << std::endl;
+            return 1;
+        }
+        for (int i = 3; i < argc; ++i) {
+            std::cout << argv[i] << " " << reader.find(argv[i]) << std::endl;
+        }
+        return 0;
+    }
+
+    // ./a1 sweep [journal] [output csv]
+    if (argc > 1 && std::string(argv[1]) == "sweep") {
+        runSweep(argc > 2 ? argv[2] : "a1-sweep.journal", argc > 3 ? argv[3] : "sweep_a1.csv");
+        return 0;
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "suffix") {
+        for (int i = 2; i < argc; ++i) {
+            testSuffixArrays(testDataHelper.readTextFromFile(argv[i]), argv[i]);
+        }
+        return 0;
+    }
+
+    std::vector<std::string> unsortedSourceArray = testDataHelper.readStrings(UNSORTED);
+    std::vector<std::string> reversedSourceArray = testDataHelper.readStrings(REVERSED);
+    std::vector<std::string> almostSortedSourceArray = testDataHelper.readStrings(ALMOST_SORTED);
 
     StringSortTester unsortedTester(unsortedSourceArray, "Unsorted");
     StringSortTester reversedTester(reversedSourceArray, "Reversed");
@@ -399,5 +1266,56 @@ int main() {
     reversedTester.testAlgorithm<HybridMSDQuickSort>("Hybrid");
     almostSortedTester.testAlgorithm<HybridMSDQuickSort>("Hybrid");
 
+    unsortedTester.testAlgorithm<IndexedMSDRadixSort>("Radix Indexed");
+    reversedTester.testAlgorithm<IndexedMSDRadixSort>("Radix Indexed");
+    almostSortedTester.testAlgorithm<IndexedMSDRadixSort>("Radix Indexed");
+
+    unsortedTester.testAlgorithm<IndexedHybridMSDQuickSort>("Hybrid Indexed");
+    reversedTester.testAlgorithm<IndexedHybridMSDQuickSort>("Hybrid Indexed");
+    almostSortedTester.testAlgorithm<IndexedHybridMSDQuickSort>("Hybrid Indexed");
+
+    unsortedTester.testAlgorithm<BurstSort>("Burst");
+    reversedTester.testAlgorithm<BurstSort>("Burst");
+    almostSortedTester.testAlgorithm<BurstSort>("Burst");
+
+    for (const std::string& filename : {URLS, PATHS}) {
+        std::vector<std::string> sourceArray = testDataHelper.readStrings(filename);
+        if (sourceArray.size() < 3000) {
+            continue;
+        }
+        StringSortTester tester(sourceArray, filename);
+        tester.testAlgorithm<MergeSort>("Merge");
+        tester.testAlgorithm<QuickSort>("Quick");
+        tester.testAlgorithm<StringMergeSort>("String Merge");
+        tester.testAlgorithm<StringQuickSort>("String Quick");
+        tester.testAlgorithm<MSDRadixSort>("Radix");
+        tester.testAlgorithm<HybridMSDQuickSort>("Hybrid");
+        tester.testAlgorithm<BurstSort>("Burst");
+        tester.testAlgorithm<IndexedMSDRadixSort>("Radix Indexed");
+        tester.testAlgorithm<IndexedHybridMSDQuickSort>("Hybrid Indexed");
+
+        tester.testAlgorithm<MergeSort>("Merge Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<QuickSort>("Quick Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<StringMergeSort>("String Merge Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<StringQuickSort>("String Quick Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<MSDRadixSort>("Radix Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<HybridMSDQuickSort>("Hybrid Distinct", OutputMode::Distinct);
+        tester.testAlgorithm<BurstSort>("Burst Distinct", OutputMode::Distinct);
+    }
+
+    for (const std::string& filename : {UNSORTED, URLS, PATHS}) {
+        std::vector<std::string> strings = testDataHelper.readStrings(filename);
+        if (!strings.empty()) {
+            testFrontCoding(strings, filename);
+        }
+    }
+
+    for (const std::string& filename : {UNSORTED, URLS}) {
+        std::string text = testDataHelper.readTextFromFile(filename);
+        if (!text.empty()) {
+            testSuffixArrays(text, filename);
+        }
+    }
+
     return 0;
 }
\ No newline at end of file
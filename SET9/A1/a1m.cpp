@@ -4,18 +4,24 @@
 #include <algorithm>
 #include <array>
 
+#include "../../common/frontCoding.h"
+
 class StringMergeSort {
 public:
     static int compareCount;
- 
-    static void sort(std::vector<std::string>& array) {
+
+    struct Entry {
+        std::string key;
+        int lcp;
+        int count;
+    };
+
+    // With distinct set, equal strings come back as one entry carrying their count.
+    static std::vector<Entry> sort(const std::vector<std::string>& array, bool distinct = false) {
         compareCount = 0;
-        auto sortedPairs = stringMergeSort(array);
-        for (int i = 0; i < array.size(); ++i) {
-            array[i] = sortedPairs[i].first;
-        }
+        return stringMergeSort(array, distinct);
     }
- 
+
 private:
     static int lcpCompare(const std::string& a, const std::string& b, int index) {
         int n = std::min(a.size(), b.size());
@@ -27,31 +33,30 @@ private:
         }
         return n;
     }
- 
-    static std::vector<std::pair<std::string, int> > stringMerge(const std::vector<std::pair<std::string, int> >& P, const std::vector<std::pair<std::string, int> >& Q) {
-        std::vector<std::pair<std::string, int> > R;
+
+    // Each head's lcp is relative to the last string written to R, so the larger one is the
+    // smaller string and characters are only compared past the shared prefix. Running off the
+    // end of both strings means they are equal; the duplicate is kept, or merged into P's.
+    static std::vector<Entry> stringMerge(std::vector<Entry>& P, std::vector<Entry>& Q, bool distinct) {
+        std::vector<Entry> R;
         int i = 0, j = 0;
         while (i < P.size() && j < Q.size()) {
-            if (P[i].first < Q[j].first) {
-                compareCount += std::min(P[i].first.size(), Q[j].first.size());
+            if (P[i].lcp > Q[j].lcp) {
                 R.push_back(P[i++]);
-            } else if (P[i].first > Q[j].first) {
-                compareCount += std::min(P[i].first.size(), Q[j].first.size());
+            } else if (P[i].lcp < Q[j].lcp) {
                 R.push_back(Q[j++]);
             } else {
-                int lcp = lcpCompare(P[i].first, Q[j].first, std::max(P[i].second, Q[j].second));
-                if (lcp < P[i].first.size() && lcp < Q[j].first.size()) {
-                    if (P[i].first[lcp] < Q[j].first[lcp]) {
-                        R.push_back({P[i].first, lcp});
-                        i++;
-                    } else {
-                        R.push_back({Q[j].first, lcp});
-                        j++;
-                    }
+                int lcp = lcpCompare(P[i].key, Q[j].key, P[i].lcp);
+                bool pEnds = lcp == P[i].key.size(), qEnds = lcp == Q[j].key.size();
+                if (pEnds && qEnds && distinct) {
+                    P[i].count += Q[j++].count;
+                    R.push_back(P[i++]);
+                } else if (pEnds || (!qEnds && (unsigned char)P[i].key[lcp] < (unsigned char)Q[j].key[lcp])) {
+                    Q[j].lcp = lcp;
+                    R.push_back(P[i++]);
                 } else {
-                    R.push_back(P[i]);
-                    i++;
-                    j++;
+                    P[i].lcp = lcp;
+                    R.push_back(Q[j++]);
                 }
             }
         }
@@ -59,26 +64,31 @@ private:
         while (j < Q.size()) R.push_back(Q[j++]);
         return R;
     }
- 
-    static std::vector<std::pair<std::string, int> > stringMergeSort(const std::vector<std::string>& strings) {
+
+    static std::vector<Entry> stringMergeSort(const std::vector<std::string>& strings, bool distinct) {
         if (strings.size() <= 1) {
             if (!strings.empty()) {
-                return {{strings[0], 0}};
+                return {{strings[0], 0, 1}};
             }
             return {};
         }
         int mid = strings.size() / 2;
         std::vector<std::string> left(strings.begin(), strings.begin() + mid);
         std::vector<std::string> right(strings.begin() + mid, strings.end());
-        auto P = stringMergeSort(left);
-        auto Q = stringMergeSort(right);
-        return stringMerge(P, Q);
+        auto P = stringMergeSort(left, distinct);
+        auto Q = stringMergeSort(right, distinct);
+        return stringMerge(P, Q, distinct);
     }
 };
 
 int StringMergeSort::compareCount = 0;
 
-int main() {
+// "./a1m distinct" prints each string once followed by its count. "./a1m front [k]" writes
+// the sorted set front coded with a restart every k keys (see common/frontCoding.h), reusing
+// the LCPs the merge already computed.
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    bool distinct = mode == "distinct";
     int n;
     std::cin >> n;
     std::vector<std::string> arr(n);
@@ -86,9 +96,23 @@ int main() {
         std::cin >> arr[i];
     }
     
-    StringMergeSort::sort(arr);
+    auto sorted = StringMergeSort::sort(arr, distinct);
+
+    if (mode == "front") {
+        FrontCodedWriter writer(argc > 2 ? std::stoi(argv[2]) : 16);
+        for (const auto& entry : sorted) {
+            writer.add(entry.key, entry.lcp);
+        }
+        std::string image = writer.finish();
+        std::cout.write(image.data(), image.size());
+        return 0;
+    }
     
-    for (const auto& s : arr) {
-        std::cout << s << '\n';
+    for (const auto& entry : sorted) {
+        if (distinct) {
+            std::cout << entry.key << ' ' << entry.count << '\n';
+        } else {
+            std::cout << entry.key << '\n';
+        }
     }
-}
\ No newline at end of file
+}
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <array>
 
+#include "../../common/frontCoding.h"
+
 class MSDRadixSort {
 public:
     static int compareCount;
@@ -49,7 +51,9 @@ private:
 
 int MSDRadixSort::compareCount = 0;
 
-int main() {
+// "./a1r front [k]" writes the sorted set front coded with a restart every k keys (see
+// common/frontCoding.h) instead of one string per line.
+int main(int argc, char* argv[]) {
     int n;
     std::cin >> n;
     std::vector<std::string> arr(n);
@@ -58,6 +62,16 @@ int main() {
     }
     
     MSDRadixSort::sort(arr);
+
+    if (argc > 1 && std::string(argv[1]) == "front") {
+        FrontCodedWriter writer(argc > 2 ? std::stoi(argv[2]) : 16);
+        for (const auto& s : arr) {
+            writer.add(s);
+        }
+        std::string image = writer.finish();
+        std::cout.write(image.data(), image.size());
+        return 0;
+    }
     
     for (const auto& s : arr) {
         std::cout << s << '\n';
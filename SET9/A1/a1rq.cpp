@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <array>
 
+#include "../../common/frontCoding.h"
+
 class StringQuickSort {
 public:
     static int compareCount;
@@ -14,13 +16,16 @@ public:
     }
 
 private:
+    // Bytes compare unsigned, like std::string; -1 past the end puts shorter strings first.
+    static int charAt(const std::string& s, int index) {
+        return index < s.size() ? static_cast<unsigned char>(s[index]) : -1;
+    }
+
     static void stringQuickSort(std::vector<std::string>& strings, int start, int end, int index) {
         if (end - start <= 1) return;
 
-        if (index >= strings[0].size()) return;
-
         int pivotIndex = start + (end - start) / 2;
-        char pivot = strings[pivotIndex][index];
+        int pivot = charAt(strings[pivotIndex], index);
 
         int less = start;
         int equal = start;
@@ -28,9 +33,10 @@ private:
 
         while (equal < greater) {
             compareCount++;
-            if (index < strings[equal].size() && strings[equal][index] < pivot) {
+            int c = charAt(strings[equal], index);
+            if (c < pivot) {
                 std::swap(strings[less++], strings[equal++]);
-            } else if (index < strings[equal].size() && strings[equal][index] == pivot) {
+            } else if (c == pivot) {
                 ++equal;
             } else {
                 std::swap(strings[equal], strings[--greater]);
@@ -38,7 +44,7 @@ private:
         }
 
         stringQuickSort(strings, start, less, index);
-        if (index < strings[0].size()) {
+        if (pivot >= 0) {
             stringQuickSort(strings, less, greater, index + 1);
         }
         stringQuickSort(strings, greater, end, index);
@@ -97,7 +103,9 @@ private:
 int StringQuickSort::compareCount = 0;
 int HybridMSDQuickSort::compareCount = 0;
 
-int main() {
+// "./a1rq front [k]" writes the sorted set front coded with a restart every k keys (see
+// common/frontCoding.h) instead of one string per line.
+int main(int argc, char* argv[]) {
     int n;
     std::cin >> n;
     std::vector<std::string> arr(n);
@@ -106,6 +114,16 @@ int main() {
     }
     
     HybridMSDQuickSort::sort(arr);
+
+    if (argc > 1 && std::string(argv[1]) == "front") {
+        FrontCodedWriter writer(argc > 2 ? std::stoi(argv[2]) : 16);
+        for (const auto& s : arr) {
+            writer.add(s);
+        }
+        std::string image = writer.finish();
+        std::cout.write(image.data(), image.size());
+        return 0;
+    }
     
     for (const auto& s : arr) {
         std::cout << s << '\n';
@@ -4,6 +4,8 @@
 #include <string>
 #include <algorithm>
 #include <fstream>
+
+#include "../../common/datasetCache.h"
  
 class StringGenerator {
 private:
@@ -70,6 +72,14 @@ void writeStringsToFile(const std::string& filename, const std::vector<std::stri
  
     file.close();
 }
+
+// Text for inspection, plus a binary string table that the testers map instead of parsing.
+void writeStrings(const std::string& filename, const std::vector<std::string>& strings, uint64_t seed) {
+    writeStringsToFile(filename, strings);
+    if (!writeDatasetFile(filename + ".bin", MappedDataset::encode(filename, seed, strings))) {
+        std::cerr << "Error writing file: " << filename << ".bin" << std::endl;
+    }
+}
  
 int main() {
     StringGenerator generator;
@@ -77,9 +87,15 @@ int main() {
     auto reversed = generator.generateReversedSortedArray(3000);
     auto almostSorted = generator.generateNearlySortedArray(3000);
  
-    writeStringsToFile("unsorted", unsorted);
-    writeStringsToFile("reversed", reversed);
-    writeStringsToFile("almost-sorted", almostSorted);
+    writeStrings("unsorted", unsorted, 0);
+    writeStrings("reversed", reversed, 0);
+    writeStrings("almost-sorted", almostSorted, 0);
+
+    const uint64_t seed = 2024;
+    WorkloadGenerator workloads(seed);
+    writeStrings("urls", workloads.urls(3000), seed);
+    writeStrings("paths", workloads.paths(3000), seed);
+    writeStrings("lognormal", workloads.randomStrings(3000), seed);
  
     return 0;
 }
\ No newline at end of file
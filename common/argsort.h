@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <cstdint>
+
+// A sort key with the position it came from. Sorting these instead of whole records moves
+// 8 bytes per element; ties are broken by index, so every engine yields the stable order.
+struct KeyIndex {
+    int32_t key;
+    uint32_t index;
+
+    bool operator<(const KeyIndex& other) const {
+        return key < other.key || (key == other.key && index < other.index);
+    }
+
+    bool operator>(const KeyIndex& other) const {
+        return other < *this;
+    }
+
+    bool operator<=(const KeyIndex& other) const {
+        return !(other < *this);
+    }
+};
+
+inline std::vector<KeyIndex> makeKeyIndex(const std::vector<int>& keys) {
+    std::vector<KeyIndex> pairs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        pairs[i] = {keys[i], static_cast<uint32_t>(i)};
+    }
+    return pairs;
+}
+
+// order[i] is the index of the element that belongs at position i.
+inline std::vector<uint32_t> orderOf(const std::vector<KeyIndex>& sortedPairs) {
+    std::vector<uint32_t> order(sortedPairs.size());
+    for (size_t i = 0; i < sortedPairs.size(); ++i) {
+        order[i] = sortedPairs[i].index;
+    }
+    return order;
+}
+
+// Sorts keys with any engine that accepts std::vector<KeyIndex>& and returns the order.
+template <typename SortPairs>
+std::vector<uint32_t> argsort(const std::vector<int>& keys, SortPairs sortPairs) {
+    std::vector<KeyIndex> pairs = makeKeyIndex(keys);
+    sortPairs(pairs);
+    return orderOf(pairs);
+}
+
+// Rearranges values into order in place by walking each cycle of the permutation once:
+// n moves plus one temporary per cycle. Visited positions are marked in order itself,
+// which is why it is taken by value.
+template <typename T>
+void applyPermutation(std::vector<T>& values, std::vector<uint32_t> order) {
+    const uint32_t done = UINT32_MAX;
+    for (size_t start = 0; start < order.size(); ++start) {
+        if (order[start] == done || order[start] == start) {
+            continue;
+        }
+        T held = std::move(values[start]);
+        size_t current = start;
+        while (order[current] != start) {
+            size_t next = order[current];
+            values[current] = std::move(values[next]);
+            order[current] = done;
+            current = next;
+        }
+        values[current] = std::move(held);
+        order[current] = done;
+    }
+}
+
+// Out-of-place alternative: result[i] = values[order[i]], split across threads. The reads
+// are random but independent, so this scales where the cycle walk cannot.
+template <typename T>
+std::vector<T> gather(const std::vector<T>& values, const std::vector<uint32_t>& order,
+                      unsigned threads = std::thread::hardware_concurrency()) {
+    std::vector<T> result(order.size());
+    size_t workers = std::max<size_t>(1, std::min<size_t>(threads, order.size() / 65536));
+    auto work = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = values[order[i]];
+        }
+    };
+    if (workers == 1) {
+        work(0, order.size());
+        return result;
+    }
+    std::vector<std::thread> pool;
+    size_t chunk = (order.size() + workers - 1) / workers;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back(work, std::min(order.size(), w * chunk), std::min(order.size(), (w + 1) * chunk));
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+    return result;
+}
+
+// Sorts keys and a parallel payload array in lockstep.
+template <typename T, typename SortPairs>
+void sortByKey(std::vector<int>& keys, std::vector<T>& payload, SortPairs sortPairs) {
+    std::vector<uint32_t> order = argsort(keys, sortPairs);
+    applyPermutation(keys, order);
+    applyPermutation(payload, std::move(order));
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+#include <memory>
+#include <functional>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "workloadGenerator.h"
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "datasets are stored little-endian and mapped as is");
+
+// On-disk layout: this header, then either count int32 values, or a string table of
+// count + 1 uint64 offsets followed by the concatenated bytes (string i is
+// blob[offsets[i], offsets[i + 1])). Everything is little-endian and mapped without parsing.
+struct DatasetHeader {
+    static constexpr char expectedMagic[8] = {'B', 'E', 'N', 'C', 'H', 'D', 'S', '\0'};
+    static constexpr uint32_t currentVersion = 1;
+
+    enum ElementType : uint32_t { Int32 = 1, StringTable = 2 };
+
+    char magic[8];
+    uint32_t version;
+    uint32_t elementType;
+    uint64_t seed;
+    uint64_t count;
+    uint64_t payloadBytes;
+    char distribution[32];
+};
+
+static_assert(sizeof(DatasetHeader) == 72, "header layout is part of the file format");
+
+class MappedDataset {
+public:
+    MappedDataset() = default;
+    MappedDataset(const MappedDataset&) = delete;
+    MappedDataset& operator=(const MappedDataset&) = delete;
+
+    ~MappedDataset() {
+        close();
+    }
+
+    static std::vector<char> encode(const std::string& distribution, uint64_t seed, const std::vector<int>& values) {
+        std::vector<char> image(sizeof(DatasetHeader) + values.size() * sizeof(int32_t));
+        writeHeader(image, DatasetHeader::Int32, distribution, seed, values.size());
+        std::memcpy(image.data() + sizeof(DatasetHeader), values.data(), values.size() * sizeof(int32_t));
+        return image;
+    }
+
+    static std::vector<char> encode(const std::string& distribution, uint64_t seed, const std::vector<std::string>& strings) {
+        size_t offsetBytes = (strings.size() + 1) * sizeof(uint64_t);
+        size_t blobBytes = 0;
+        for (const auto& s : strings) {
+            blobBytes += s.size();
+        }
+        std::vector<char> image(sizeof(DatasetHeader) + offsetBytes + blobBytes);
+        writeHeader(image, DatasetHeader::StringTable, distribution, seed, strings.size());
+        char* offsets = image.data() + sizeof(DatasetHeader);
+        char* blob = offsets + offsetBytes;
+        uint64_t offset = 0;
+        for (size_t i = 0; i <= strings.size(); ++i) {
+            std::memcpy(offsets + i * sizeof(uint64_t), &offset, sizeof(offset));
+            if (i < strings.size()) {
+                std::memcpy(blob + offset, strings[i].data(), strings[i].size());
+                offset += strings[i].size();
+            }
+        }
+        return image;
+    }
+
+    // Maps an existing file read-only. Returns false, leaving the dataset empty, if the file
+    // is missing or its header does not describe a complete dataset of a known version.
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(DatasetHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        mapping = mapped;
+        bytes = st.st_size;
+        data = static_cast<const char*>(mapped);
+        if (!valid()) {
+            std::cerr << "Ignoring invalid dataset file: " << path << std::endl;
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Holds an encoded image in memory, for when the cache directory cannot be written.
+    void adopt(std::vector<char> image) {
+        close();
+        memory = std::move(image);
+        data = memory.data();
+        bytes = memory.size();
+    }
+
+    void close() {
+        if (mapping) {
+            munmap(mapping, bytes);
+        }
+        mapping = nullptr;
+        memory.clear();
+        data = nullptr;
+        bytes = 0;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return data == nullptr;
+    }
+
+    const DatasetHeader& header() const {
+        return *reinterpret_cast<const DatasetHeader*>(data);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return empty() ? 0 : header().count;
+    }
+
+    const int32_t* ints() const {
+        return reinterpret_cast<const int32_t*>(data + sizeof(DatasetHeader));
+    }
+
+    std::string_view string(size_t i) const {
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + sizeof(DatasetHeader));
+        const char* blob = reinterpret_cast<const char*>(offsets + header().count + 1);
+        return std::string_view(blob + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+private:
+    void* mapping = nullptr;
+    std::vector<char> memory;
+    const char* data = nullptr;
+    size_t bytes = 0;
+
+    static void writeHeader(std::vector<char>& image, uint32_t elementType, const std::string& distribution,
+                            uint64_t seed, uint64_t count) {
+        DatasetHeader header{};
+        std::memcpy(header.magic, DatasetHeader::expectedMagic, sizeof(header.magic));
+        header.version = DatasetHeader::currentVersion;
+        header.elementType = elementType;
+        header.seed = seed;
+        header.count = count;
+        header.payloadBytes = image.size() - sizeof(DatasetHeader);
+        std::strncpy(header.distribution, distribution.c_str(), sizeof(header.distribution) - 1);
+        std::memcpy(image.data(), &header, sizeof(header));
+    }
+
+    bool valid() const {
+        const DatasetHeader& h = header();
+        if (std::memcmp(h.magic, DatasetHeader::expectedMagic, sizeof(h.magic)) != 0 ||
+            h.version != DatasetHeader::currentVersion || h.payloadBytes != bytes - sizeof(DatasetHeader) ||
+            h.count > bytes) {
+            return false;
+        }
+        if (h.elementType == DatasetHeader::Int32) {
+            return h.payloadBytes == h.count * sizeof(int32_t);
+        }
+        if (h.elementType == DatasetHeader::StringTable) {
+            uint64_t offsetBytes = (h.count + 1) * sizeof(uint64_t);
+            if (h.payloadBytes < offsetBytes) {
+                return false;
+            }
+            const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + sizeof(DatasetHeader));
+            return offsets[h.count] == h.payloadBytes - offsetBytes;
+        }
+        return false;
+    }
+};
+
+// Writes through a temporary file so a concurrent reader never maps a half-written dataset.
+inline bool writeDatasetFile(const std::string& path, const std::vector<char>& image) {
+    std::string temporary = path + ".tmp" + std::to_string(getpid());
+    std::ofstream file(temporary, std::ios::binary);
+    file.write(image.data(), image.size());
+    file.close();
+    if (file && std::rename(temporary.c_str(), path.c_str()) == 0) {
+        return true;
+    }
+    std::remove(temporary.c_str());
+    return false;
+}
+
+// Generates each named dataset once with WorkloadGenerator, stores it under directory and
+// maps it on every later run. A cached file is reused when its seed matches and it holds at
+// least the requested number of elements; callers take prefixes of it. Asking for more
+// elements than the file holds regenerates and remaps it, so copy out what you need.
+class DatasetCache {
+public:
+    template <typename T>
+    using Maker = std::function<std::vector<T>(const WorkloadGenerator&, size_t)>;
+
+    explicit DatasetCache(std::string directory = "datasets", uint64_t seed = 2024)
+        : directory(std::move(directory)), seed(seed), workloads(seed) {}
+
+    const MappedDataset& ints(const std::string& distribution, size_t n, const Maker<int>& make) {
+        return load(distribution, DatasetHeader::Int32, n, [&](size_t count) {
+            return MappedDataset::encode(distribution, seed, make(workloads, count));
+        });
+    }
+
+    const MappedDataset& strings(const std::string& distribution, size_t n, const Maker<std::string>& make) {
+        return load(distribution, DatasetHeader::StringTable, n, [&](size_t count) {
+            return MappedDataset::encode(distribution, seed, make(workloads, count));
+        });
+    }
+
+private:
+    std::string directory;
+    uint64_t seed;
+    WorkloadGenerator workloads;
+    std::map<std::string, std::unique_ptr<MappedDataset>> opened;
+
+    template <typename Encode>
+    const MappedDataset& load(const std::string& distribution, uint32_t elementType, size_t n, Encode encode) {
+        std::unique_ptr<MappedDataset>& dataset = opened[distribution];
+        if (!dataset) {
+            dataset = std::make_unique<MappedDataset>();
+        }
+        if (usable(*dataset, elementType, n)) {
+            return *dataset;
+        }
+        std::string path = directory + "/" + distribution + "-" + std::to_string(seed) + ".bin";
+        if (dataset->open(path) && usable(*dataset, elementType, n)) {
+            return *dataset;
+        }
+
+        std::vector<char> image = encode(n);
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (writeDatasetFile(path, image) && dataset->open(path)) {
+            return *dataset;
+        }
+        std::cerr << "Could not write dataset cache " << path << ", keeping it in memory" << std::endl;
+        dataset->adopt(std::move(image));
+        return *dataset;
+    }
+
+    bool usable(const MappedDataset& dataset, uint32_t elementType, size_t n) const {
+        return !dataset.empty() && dataset.header().elementType == elementType && dataset.header().seed == seed &&
+               dataset.size() >= n;
+    }
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "front-coded files are stored little-endian");
+
+// Front coding for sorted string sets. Keys are grouped into blocks of restartInterval; each
+// entry is varint lcp (with the previous key), varint suffix length and the suffix bytes. The
+// first entry of a block is a restart point with lcp 0, so it holds its whole key and a block
+// decodes without anything before it.
+//
+// File layout: this header, the entries, then blockCount uint64 offsets of the restart
+// entries counted from the end of the header (the block index).
+struct FrontCodedHeader {
+    static constexpr char expectedMagic[8] = {'F', 'R', 'O', 'N', 'T', 'C', 'D', '\0'};
+    static constexpr uint32_t currentVersion = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t restartInterval;
+    uint64_t count;
+    uint64_t blockCount;
+    uint64_t indexOffset;
+};
+
+static_assert(sizeof(FrontCodedHeader) == 40, "header layout is part of the file format");
+
+namespace front_coding {
+
+inline void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Returns false on a truncated or overlong varint.
+inline bool getVarint(const char*& p, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace front_coding
+
+// Keys must be added in sorted order. add(key, lcp) takes the LCP with the previous key from
+// the caller, e.g. an LCP merge sort that already knows it; add(key) computes it.
+class FrontCodedWriter {
+public:
+    explicit FrontCodedWriter(uint32_t restartInterval = 16) : restartInterval(std::max<uint32_t>(restartInterval, 1)) {}
+
+    void add(std::string_view key) {
+        size_t lcp = 0;
+        size_t n = std::min(key.size(), previous.size());
+        while (lcp < n && key[lcp] == previous[lcp]) {
+            ++lcp;
+        }
+        add(key, lcp);
+    }
+
+    void add(std::string_view key, size_t lcp) {
+        if (count % restartInterval == 0) {
+            restarts.push_back(entries.size());
+            lcp = 0;
+        }
+        front_coding::putVarint(entries, lcp);
+        front_coding::putVarint(entries, key.size() - lcp);
+        entries.append(key.data() + lcp, key.size() - lcp);
+        previous.assign(key.data(), key.size());
+        ++count;
+    }
+
+    std::string finish() const {
+        FrontCodedHeader header{};
+        std::memcpy(header.magic, FrontCodedHeader::expectedMagic, sizeof(header.magic));
+        header.version = FrontCodedHeader::currentVersion;
+        header.restartInterval = restartInterval;
+        header.count = count;
+        header.blockCount = restarts.size();
+        header.indexOffset = sizeof(FrontCodedHeader) + entries.size();
+
+        std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+        image += entries;
+        image.append(reinterpret_cast<const char*>(restarts.data()), restarts.size() * sizeof(uint64_t));
+        return image;
+    }
+
+private:
+    uint32_t restartInterval;
+    uint64_t count = 0;
+    std::string entries;
+    std::string previous;
+    std::vector<uint64_t> restarts;
+};
+
+// Looks keys up without decoding the whole set: a binary search over the restart keys, which
+// are stored whole, picks one block, and only that block is decoded.
+class FrontCodedReader {
+public:
+    // Returns false, leaving the reader empty, if the file is missing or not a complete
+    // front-coded set of a known version.
+    bool open(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        return adopt(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+    }
+
+    bool adopt(std::string bytes) {
+        image = std::move(bytes);
+        if (!valid()) {
+            image.clear();
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return image.empty();
+    }
+
+    const FrontCodedHeader& header() const {
+        return *reinterpret_cast<const FrontCodedHeader*>(image.data());
+    }
+
+    [[nodiscard]] size_t size() const {
+        return empty() ? 0 : header().count;
+    }
+
+    std::string key(size_t i) const {
+        std::string current;
+        uint64_t block = i / header().restartInterval;
+        const char* p = entries() + restart(block);
+        for (uint64_t j = block * header().restartInterval; j <= i; ++j) {
+            next(p, current);
+        }
+        return current;
+    }
+
+    // Index of the first key not less than key, or size() if there is none. The search finds
+    // the first block whose restart key is not less than key; the answer is in the block
+    // before it or is that restart itself.
+    size_t lowerBound(std::string_view key) const {
+        if (empty()) {
+            return 0;
+        }
+        uint64_t lo = 0, hi = header().blockCount;
+        while (lo < hi) {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (restartKey(mid) < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == 0) {
+            return 0;
+        }
+        uint64_t block = lo - 1;
+        uint64_t first = block * header().restartInterval;
+        uint64_t last = std::min<uint64_t>(first + header().restartInterval, header().count);
+        const char* p = entries() + restart(block);
+        std::string current;
+        for (uint64_t i = first; i < last; ++i) {
+            next(p, current);
+            if (current >= key) {
+                return i;
+            }
+        }
+        return last;
+    }
+
+    // Index of key, or -1 if it is not in the set.
+    long find(std::string_view key) const {
+        size_t i = lowerBound(key);
+        return i < size() && this->key(i) == key ? static_cast<long>(i) : -1;
+    }
+
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        const char* p = entries();
+        std::string current;
+        for (uint64_t i = 0; i < size(); ++i) {
+            next(p, current);
+            visit(std::string_view(current));
+        }
+    }
+
+private:
+    std::string image;
+
+    const char* entries() const {
+        return image.data() + sizeof(FrontCodedHeader);
+    }
+
+    const char* entriesEnd() const {
+        return image.data() + header().indexOffset;
+    }
+
+    uint64_t restart(uint64_t block) const {
+        uint64_t offset;
+        std::memcpy(&offset, image.data() + header().indexOffset + block * sizeof(uint64_t), sizeof(offset));
+        return offset;
+    }
+
+    std::string_view restartKey(uint64_t block) const {
+        const char* p = entries() + restart(block);
+        uint64_t lcp, length;
+        front_coding::getVarint(p, entriesEnd(), lcp);
+        front_coding::getVarint(p, entriesEnd(), length);
+        return std::string_view(p, length);
+    }
+
+    // Decodes the entry at p into current, which holds the previous key, and advances p.
+    void next(const char*& p, std::string& current) const {
+        uint64_t lcp, length;
+        front_coding::getVarint(p, entriesEnd(), lcp);
+        front_coding::getVarint(p, entriesEnd(), length);
+        current.resize(lcp);
+        current.append(p, length);
+        p += length;
+    }
+
+    // Walks every entry once, so lookups can trust the offsets and lengths they decode.
+    bool valid() const {
+        if (image.size() < sizeof(FrontCodedHeader)) {
+            return false;
+        }
+        const FrontCodedHeader& h = header();
+        if (std::memcmp(h.magic, FrontCodedHeader::expectedMagic, sizeof(h.magic)) != 0 ||
+            h.version != FrontCodedHeader::currentVersion || h.restartInterval == 0 ||
+            h.indexOffset < sizeof(FrontCodedHeader) || h.indexOffset > image.size() ||
+            (image.size() - h.indexOffset) / sizeof(uint64_t) != h.blockCount ||
+            (image.size() - h.indexOffset) % sizeof(uint64_t) != 0 ||
+            h.blockCount != (h.count + h.restartInterval - 1) / h.restartInterval) {
+            return false;
+        }
+        const char* p = entries();
+        uint64_t previousLength = 0;
+        for (uint64_t i = 0; i < h.count; ++i) {
+            uint64_t lcp, length;
+            bool isRestart = i % h.restartInterval == 0;
+            if (isRestart && restart(i / h.restartInterval) != static_cast<uint64_t>(p - entries())) {
+                return false;
+            }
+            if (!front_coding::getVarint(p, entriesEnd(), lcp) || !front_coding::getVarint(p, entriesEnd(), length) ||
+                lcp > previousLength || (isRestart && lcp != 0) || length > static_cast<uint64_t>(entriesEnd() - p)) {
+                return false;
+            }
+            p += length;
+            previousLength = lcp + length;
+        }
+        return p == entriesEnd();
+    }
+};
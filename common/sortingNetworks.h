@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Leaf sorters for 0..32 elements. The networks are Batcher's odd-even merge sort on the next
+// power of two, generated at compile time with every comparator that touches a padding slot
+// dropped. That is the optimal comparator count up to 8 inputs and a few comparators over the
+// best known networks beyond it (63 vs 60 for 16), in exchange for needing no tables.
+namespace sorting_network {
+
+constexpr int maxSize = 32;
+
+struct Comparator {
+    int low, high;
+};
+
+// Calls visit(layer, low, high) for every comparator; comparators in one layer are disjoint.
+template <typename Visit>
+constexpr void batcher(int n, Visit&& visit) {
+    int size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    int layer = 0;
+    for (int p = 1; p < size; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1, ++layer) {
+            for (int j = k % p; j + k < size; j += 2 * k) {
+                for (int i = 0; i < k; ++i) {
+                    int a = i + j, b = i + j + k;
+                    if (b < n && a / (2 * p) == b / (2 * p)) {
+                        visit(layer, a, b);
+                    }
+                }
+            }
+        }
+    }
+}
+
+constexpr int comparatorCount(int n) {
+    int count = 0;
+    batcher(n, [&](int, int, int) { ++count; });
+    return count;
+}
+
+template <int N>
+struct Network {
+    static constexpr std::array<Comparator, comparatorCount(N)> build() {
+        std::array<Comparator, comparatorCount(N)> result{};
+        int count = 0;
+        batcher(N, [&](int, int a, int b) { result[count++] = {a, b}; });
+        return result;
+    }
+
+    static constexpr auto comparators = build();
+};
+
+// Both outputs are selected from one comparison, which the compiler turns into cmov (or
+// pminsd/pmaxsd once it vectorizes), so the network runs without data-dependent branches.
+template <typename T>
+inline void compareExchange(T& a, T& b) {
+    bool swap = b < a;
+    T lo = swap ? b : a;
+    T hi = swap ? a : b;
+    a = lo;
+    b = hi;
+}
+
+template <int N, typename T, size_t... I>
+inline void applyNetwork([[maybe_unused]] T* x, std::index_sequence<I...>) {
+    (compareExchange(x[Network<N>::comparators[I].low], x[Network<N>::comparators[I].high]), ...);
+}
+
+template <int N, typename T>
+void sortFixed(T* x) {
+    applyNetwork<N>(x, std::make_index_sequence<Network<N>::comparators.size()>());
+}
+
+#ifdef __AVX2__
+// The same networks held in ymm registers: each layer becomes one permute to fetch partners,
+// a min, a max and a blend picking the max on the lanes that are the high end of a comparator.
+template <int N>
+struct SimdNetwork {
+    static constexpr int registers = N / 8;
+    static constexpr int layers = [] {
+        int count = 0;
+        batcher(N, [&](int layer, int, int) { count = std::max(count, layer + 1); });
+        return count;
+    }();
+
+    struct Step {
+        int32_t index[registers][8];
+        int32_t fromHigh[registers][8];
+        int32_t takeMax[registers][8];
+    };
+
+    static constexpr std::array<Step, layers> build() {
+        int partner[layers][N]{};
+        int isHigh[layers][N]{};
+        for (int l = 0; l < layers; ++l) {
+            for (int i = 0; i < N; ++i) {
+                partner[l][i] = i;
+            }
+        }
+        batcher(N, [&](int layer, int a, int b) {
+            partner[layer][a] = b;
+            partner[layer][b] = a;
+            isHigh[layer][b] = 1;
+        });
+        std::array<Step, layers> steps{};
+        for (int l = 0; l < layers; ++l) {
+            for (int i = 0; i < N; ++i) {
+                steps[l].index[i / 8][i % 8] = partner[l][i] % 8;
+                steps[l].fromHigh[i / 8][i % 8] = partner[l][i] >= 8 ? -1 : 0;
+                steps[l].takeMax[i / 8][i % 8] = isHigh[l][i] ? -1 : 0;
+            }
+        }
+        return steps;
+    }
+
+    static constexpr auto steps = build();
+};
+
+inline __m256i load8(const int32_t* x) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+}
+
+inline void sort8Avx2(int32_t* x) {
+    __m256i v = load8(x);
+    for (const auto& step : SimdNetwork<8>::steps) {
+        __m256i other = _mm256_permutevar8x32_epi32(v, load8(step.index[0]));
+        v = _mm256_blendv_epi8(_mm256_min_epi32(v, other), _mm256_max_epi32(v, other), load8(step.takeMax[0]));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(x), v);
+}
+
+inline void sort16Avx2(int32_t* x) {
+    __m256i v[2] = {load8(x), load8(x + 8)};
+    for (const auto& step : SimdNetwork<16>::steps) {
+        __m256i other[2];
+        for (int r = 0; r < 2; ++r) {
+            __m256i index = load8(step.index[r]);
+            other[r] = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(v[0], index),
+                                          _mm256_permutevar8x32_epi32(v[1], index), load8(step.fromHigh[r]));
+        }
+        for (int r = 0; r < 2; ++r) {
+            v[r] = _mm256_blendv_epi8(_mm256_min_epi32(v[r], other[r]), _mm256_max_epi32(v[r], other[r]),
+                                      load8(step.takeMax[r]));
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(x), v[0]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(x + 8), v[1]);
+}
+#endif
+
+template <typename T, size_t... N>
+constexpr std::array<void (*)(T*), sizeof...(N)> makeTable(std::index_sequence<N...>) {
+    return {{&sortFixed<static_cast<int>(N), T>...}};
+}
+
+// Sorts x[0..n) for n <= maxSize.
+template <typename T>
+void sortSmall(T* x, int n) {
+#ifdef __AVX2__
+    if constexpr (std::is_same<T, int32_t>::value) {
+        if (n == 8) {
+            sort8Avx2(x);
+            return;
+        }
+        if (n == 16) {
+            sort16Avx2(x);
+            return;
+        }
+    }
+#endif
+    static constexpr auto table = makeTable<T>(std::make_index_sequence<maxSize + 1>());
+    table[n](x);
+}
+
+}  // namespace sorting_network
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// One logical CPU per physical core that this process may run on, so that pinned workers
+// never share a core with each other. The first core is left to the OS when there are more
+// than two.
+inline std::vector<int> isolatedCores() {
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        std::set<std::string> seen;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed)) {
+                continue;
+            }
+            std::ifstream siblings("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+            std::string group;
+            if (!std::getline(siblings, group)) {
+                group = std::to_string(cpu);
+            }
+            if (seen.insert(group).second) {
+                cores.push_back(cpu);
+            }
+        }
+    }
+    if (cores.size() > 2) {
+        cores.erase(cores.begin());
+    }
+#endif
+    if (cores.empty()) {
+        cores.push_back(-1);
+    }
+    return cores;
+}
+
+inline void pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// Runs the cells of a benchmark parameter grid on pinned cores and reassembles their output
+// in grid order, so the merged result reads as if the sweep had run serially.
+//
+// Each cell writes to a fixed number of output streams. Finished cells are appended to a
+// journal file as they complete; a later run with the same journal reuses every cell whose
+// key it finds there and only runs the rest, so an interrupted sweep resumes where it
+// stopped. Keys must be unique and must not contain newlines. Cells run concurrently and
+// must not share mutable state.
+class SweepRunner {
+public:
+    using Output = std::vector<std::ostringstream>;
+    using Cell = std::function<void(Output&)>;
+
+    // workers = 0 uses one worker per isolated core.
+    explicit SweepRunner(std::string journalPath, size_t streams = 1, unsigned workers = 0)
+        : journalPath(std::move(journalPath)), streams(streams), workers(workers) {}
+
+    // Fixed text, such as a CSV header, emitted at this position of the grid.
+    void text(const std::string& text, size_t stream = 0) {
+        Item item;
+        item.output.resize(streams);
+        item.output[stream] = text;
+        item.done = true;
+        items.push_back(std::move(item));
+    }
+
+    void add(const std::string& key, Cell cell) {
+        Item item;
+        item.key = key;
+        item.cell = std::move(cell);
+        items.push_back(std::move(item));
+    }
+
+    // Runs every cell missing from the journal, then writes the merged output of stream i to
+    // destinations[i].
+    void run(const std::vector<std::ostream*>& destinations) {
+        std::map<std::string, std::vector<std::string>> finished = loadJournal();
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (items[i].done) {
+                continue;
+            }
+            auto found = finished.find(items[i].key);
+            if (found != finished.end() && found->second.size() == streams) {
+                items[i].output = found->second;
+                items[i].done = true;
+                ++reusedCells;
+            } else {
+                pending.push_back(i);
+            }
+        }
+
+        std::vector<int> cores = isolatedCores();
+        size_t threads = std::min<size_t>(workers ? workers : cores.size(), pending.size());
+        std::ofstream journal(journalPath, std::ios::binary | std::ios::app);
+        std::mutex journalMutex;
+        std::atomic<size_t> next{0};
+        size_t completed = 0;
+        auto work = [&](size_t worker) {
+            pinCurrentThread(cores[worker % cores.size()]);
+            for (size_t p = next++; p < pending.size(); p = next++) {
+                Item& item = items[pending[p]];
+                Output output(streams);
+                item.cell(output);
+                std::vector<std::string> text(streams);
+                for (size_t s = 0; s < streams; ++s) {
+                    text[s] = output[s].str();
+                }
+                std::lock_guard<std::mutex> lock(journalMutex);
+                appendRecord(journal, item.key, text);
+                item.output = std::move(text);
+                item.done = true;
+                std::cerr << "[" << ++completed << "/" << pending.size() << "] " << item.key << std::endl;
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t w = 0; w < threads; ++w) {
+            pool.emplace_back(work, w);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+        ranCells = pending.size();
+
+        for (const Item& item : items) {
+            for (size_t s = 0; s < streams && s < destinations.size(); ++s) {
+                *destinations[s] << item.output[s];
+            }
+        }
+        for (std::ostream* destination : destinations) {
+            destination->flush();
+        }
+    }
+
+    [[nodiscard]] size_t reused() const {
+        return reusedCells;
+    }
+
+    [[nodiscard]] size_t ran() const {
+        return ranCells;
+    }
+
+private:
+    struct Item {
+        std::string key;
+        Cell cell;
+        std::vector<std::string> output;
+        bool done = false;
+    };
+
+    std::string journalPath;
+    size_t streams;
+    unsigned workers;
+    std::vector<Item> items;
+    size_t reusedCells = 0;
+    size_t ranCells = 0;
+
+    // Record: "cell <key>\n", the stream count, then per stream its byte length and bytes, then
+    // "end\n". Flushed whole, so a crash can only leave a truncated last record.
+    static void appendRecord(std::ofstream& journal, const std::string& key, const std::vector<std::string>& text) {
+        std::ostringstream record;
+        record << "cell " << key << "\n" << text.size() << "\n";
+        for (const std::string& stream : text) {
+            record << stream.size() << "\n" << stream;
+        }
+        record << "end\n";
+        journal << record.str();
+        journal.flush();
+    }
+
+    // Reads every complete record and cuts off a truncated tail, so that new records are
+    // appended after the last good one.
+    std::map<std::string, std::vector<std::string>> loadJournal() const {
+        std::map<std::string, std::vector<std::string>> finished;
+        std::ifstream journal(journalPath, std::ios::binary);
+        if (!journal.is_open()) {
+            return finished;
+        }
+        std::streamoff good = 0;
+        std::string line;
+        while (std::getline(journal, line) && line.rfind("cell ", 0) == 0) {
+            std::string key = line.substr(5);
+            size_t count = 0;
+            if (!std::getline(journal, line) || !(std::istringstream(line) >> count)) {
+                break;
+            }
+            std::vector<std::string> text(count);
+            bool complete = true;
+            for (size_t s = 0; s < count && complete; ++s) {
+                size_t length = 0;
+                complete = std::getline(journal, line) && (std::istringstream(line) >> length);
+                if (complete) {
+                    text[s].resize(length);
+                    complete = static_cast<bool>(journal.read(&text[s][0], length));
+                }
+            }
+            if (!complete || !std::getline(journal, line) || line != "end") {
+                break;
+            }
+            finished[key] = std::move(text);
+            good = journal.tellg();
+        }
+        journal.close();
+        std::error_code error;
+        if (std::filesystem::file_size(journalPath, error) != static_cast<uintmax_t>(good) && !error) {
+            std::cerr << "Discarding incomplete tail of sweep journal " << journalPath << std::endl;
+            std::filesystem::resize_file(journalPath, good, error);
+        }
+        return finished;
+    }
+};
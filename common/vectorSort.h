@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "sortingNetworks.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VECTOR_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+// Quicksort for 32-bit keys that partitions a whole vector per step (compare, then compress
+// the lanes below the pivot to the left and the rest to the right) and sorts the leaves with
+// bitonic networks held in registers. The AVX2 and AVX-512 versions are compiled side by side
+// and picked at runtime; without either, std::sort is used. uint32 and float keys are mapped
+// to int32 with an order-preserving bit flip, sorted, and mapped back. NaNs are not supported.
+namespace vector_sort {
+
+enum class Isa { Scalar, Avx2, Avx512 };
+
+inline const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Avx512:
+            return "AVX-512";
+        case Isa::Avx2:
+            return "AVX2";
+        default:
+            return "scalar";
+    }
+}
+
+inline Isa detectIsa() {
+#ifdef VECTOR_SORT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Isa::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::Avx2;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+inline Isa bestIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+#ifdef VECTOR_SORT_X86
+
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+// Permutations that move the lanes set in a movemask to the front, in order, followed by
+// the remaining lanes; AVX2 has no compress instruction.
+struct CompressTable {
+    int32_t index[256][8];
+
+    constexpr CompressTable() : index() {
+        for (int mask = 0; mask < 256; ++mask) {
+            int count = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    index[mask][count++] = lane;
+                }
+            }
+            for (int lane = 0; lane < 8; ++lane) {
+                if (!(mask & (1 << lane))) {
+                    index[mask][count++] = lane;
+                }
+            }
+        }
+    }
+};
+
+struct V {
+    using reg = __m256i;
+    static constexpr int width = 8;
+
+    static reg set1(int32_t x) {
+        return _mm256_set1_epi32(x);
+    }
+
+    static reg loadu(const int32_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static void storeu(int32_t* p, reg v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static reg laneMask(int n) {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    // Lanes at or past n read as INT32_MAX so they sort to the end.
+    static reg loadPadded(const int32_t* p, int n) {
+        reg mask = laneMask(n);
+        return _mm256_blendv_epi8(_mm256_set1_epi32(INT32_MAX), _mm256_maskload_epi32(p, mask), mask);
+    }
+
+    static void storePartial(int32_t* p, reg v, int n) {
+        _mm256_maskstore_epi32(p, laneMask(n), v);
+    }
+
+    static reg min(reg a, reg b) {
+        return _mm256_min_epi32(a, b);
+    }
+
+    static reg max(reg a, reg b) {
+        return _mm256_max_epi32(a, b);
+    }
+
+    template <int J>
+    static reg permuteXor(reg v) {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+    }
+
+    template <uint32_t Mask>
+    static reg blend(reg a, reg b) {
+        return _mm256_blend_epi32(a, b, Mask);
+    }
+
+    static void partitionStore(reg v, reg pivot, int32_t* a, size_t& storeL, size_t& storeR) {
+        static constexpr CompressTable table;
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+        int count = __builtin_popcount(mask);
+        reg packed = _mm256_permutevar8x32_epi32(v, loadu(table.index[mask]));
+        storeu(a + storeL, packed);
+        storeu(a + storeR - width, packed);
+        storeL += count;
+        storeR -= width - count;
+    }
+};
+
+#include "vectorSortKernels.inc"
+
+}  // namespace avx2
+
+#ifdef __clang__
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+namespace avx512 {
+
+struct V {
+    using reg = __m512i;
+    static constexpr int width = 16;
+
+    static reg set1(int32_t x) {
+        return _mm512_set1_epi32(x);
+    }
+
+    static reg loadu(const int32_t* p) {
+        return _mm512_loadu_si512(p);
+    }
+
+    static void storeu(int32_t* p, reg v) {
+        _mm512_storeu_si512(p, v);
+    }
+
+    static __mmask16 laneMask(int n) {
+        return static_cast<__mmask16>(n >= width ? 0xFFFF : n <= 0 ? 0 : (1u << n) - 1);
+    }
+
+    static reg loadPadded(const int32_t* p, int n) {
+        return _mm512_mask_loadu_epi32(_mm512_set1_epi32(INT32_MAX), laneMask(n), p);
+    }
+
+    static void storePartial(int32_t* p, reg v, int n) {
+        _mm512_mask_storeu_epi32(p, laneMask(n), v);
+    }
+
+    // The masked forms with an explicit source avoid a spurious -Wuninitialized that GCC 12
+    // reports for the plain intrinsics; with a full mask they are the same instruction.
+    static reg min(reg a, reg b) {
+        return _mm512_mask_min_epi32(a, 0xFFFF, a, b);
+    }
+
+    static reg max(reg a, reg b) {
+        return _mm512_mask_max_epi32(a, 0xFFFF, a, b);
+    }
+
+    template <int J>
+    static reg permuteXor(reg v) {
+        return _mm512_mask_permutexvar_epi32(v, 0xFFFF, _mm512_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J,
+                                                          8 ^ J, 9 ^ J, 10 ^ J, 11 ^ J, 12 ^ J, 13 ^ J, 14 ^ J, 15 ^ J),
+                                        v);
+    }
+
+    template <uint32_t Mask>
+    static reg blend(reg a, reg b) {
+        return _mm512_mask_blend_epi32(static_cast<__mmask16>(Mask), a, b);
+    }
+
+    static void partitionStore(reg v, reg pivot, int32_t* a, size_t& storeL, size_t& storeR) {
+        __mmask16 mask = _mm512_cmplt_epi32_mask(v, pivot);
+        int count = __builtin_popcount(mask);
+        _mm512_mask_compressstoreu_epi32(a + storeL, mask, v);
+        _mm512_mask_compressstoreu_epi32(a + storeR - (width - count), static_cast<__mmask16>(~mask), v);
+        storeL += count;
+        storeR -= width - count;
+    }
+};
+
+#include "vectorSortKernels.inc"
+
+}  // namespace avx512
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif  // VECTOR_SORT_X86
+
+inline void sort(int32_t* a, size_t n, Isa isa = bestIsa()) {
+    int depthLimit = 0;
+    for (size_t m = n; m > 1; m >>= 1) {
+        depthLimit += 2;
+    }
+    isa = std::min(isa, bestIsa());
+#ifdef VECTOR_SORT_X86
+    if (isa == Isa::Avx512) {
+        avx512::sortRange(a, n, depthLimit);
+        return;
+    }
+    if (isa == Isa::Avx2) {
+        avx2::sortRange(a, n, depthLimit);
+        return;
+    }
+#endif
+    std::sort(a, a + n);
+}
+
+// Both mappings are their own inverse.
+inline int32_t flipUnsigned(uint32_t x) {
+    return static_cast<int32_t>(x ^ 0x80000000u);
+}
+
+inline int32_t flipFloat(int32_t bits) {
+    return bits ^ ((bits >> 31) & 0x7FFFFFFF);
+}
+
+// Keys of another 32-bit type are copied into an int32_t buffer with memcpy, mapped, sorted
+// and copied back, so the caller's array is never accessed through an int32_t lvalue.
+template <typename T, typename Flip>
+inline void sortAsInt32(T* a, size_t n, Isa isa, Flip flip) {
+    static_assert(sizeof(T) == sizeof(int32_t), "keys must be 32 bits");
+    if (n == 0) {
+        return;
+    }
+    std::vector<int32_t> keys(n);
+    std::memcpy(keys.data(), a, n * sizeof(T));
+    for (int32_t& key : keys) {
+        key = flip(key);
+    }
+    sort(keys.data(), n, isa);
+    for (int32_t& key : keys) {
+        key = flip(key);
+    }
+    std::memcpy(a, keys.data(), n * sizeof(T));
+}
+
+inline void sort(uint32_t* a, size_t n, Isa isa = bestIsa()) {
+    sortAsInt32(a, n, isa, [](int32_t key) { return flipUnsigned(static_cast<uint32_t>(key)); });
+}
+
+inline void sort(float* a, size_t n, Isa isa = bestIsa()) {
+    sortAsInt32(a, n, isa, flipFloat);
+}
+
+}  // namespace vector_sort
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <cstdint>
+
+// Rejection-inversion sampling (Hormann & Derflinger), O(1) per draw for any n.
+// Returns ranks in [0, n), rank 0 being the most frequent.
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t n, double exponent)
+        : n(n), s(exponent), hIntegralX1(h_integral(1.5) - 1), hIntegralN(h_integral(n + 0.5)),
+          s2(2 - h_integral_inverse(h_integral(2.5) - h(2))) {}
+
+    template <typename Engine>
+    uint64_t operator()(Engine& rand_engine) const {
+        std::uniform_real_distribution<double> unif(0.0, 1.0);
+        while (true) {
+            double u = hIntegralN + unif(rand_engine) * (hIntegralX1 - hIntegralN);
+            double x = h_integral_inverse(u);
+            uint64_t k = static_cast<uint64_t>(std::min(std::max(x + 0.5, 1.0), static_cast<double>(n)));
+            if (k - x <= s2 || u >= h_integral(k + 0.5) - h(k)) {
+                return k - 1;
+            }
+        }
+    }
+
+private:
+    uint64_t n;
+    double s, hIntegralX1, hIntegralN, s2;
+
+    double h(double x) const {
+        return std::exp(-s * std::log(x));
+    }
+
+    double h_integral(double x) const {
+        double logX = std::log(x);
+        return helper2((1 - s) * logX) * logX;
+    }
+
+    double h_integral_inverse(double x) const {
+        double t = std::max(x * (1 - s), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+
+    static double helper1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+    }
+
+    static double helper2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x * (1.0 / 3) * (1 + 0.25 * x));
+    }
+};
+
+// Deterministic benchmark inputs. The output is cut into fixed chunks and every chunk gets its
+// own engine seeded from (seed, stream, chunk), so a fill gives the same bytes no matter how
+// many threads produce it.
+class WorkloadGenerator {
+public:
+    static constexpr size_t chunkSize = 1 << 16;
+
+    explicit WorkloadGenerator(uint64_t seed = 2024, unsigned threads = std::thread::hardware_concurrency())
+        : seed(seed), threads(std::max(1u, threads)) {}
+
+    std::vector<int> uniform(size_t n, int minVal, int maxVal) const {
+        return fill<int>(n, 1, [=](int* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            std::uniform_int_distribution<int> unif(minVal, maxVal);
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = unif(rand_engine);
+            }
+        });
+    }
+
+    std::vector<int> zipf(size_t n, uint64_t universe, double exponent = 0.99) const {
+        ZipfSampler sampler(universe, exponent);
+        return fill<int>(n, 2, [=](int* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = static_cast<int>(sampler(rand_engine));
+            }
+        });
+    }
+
+    std::vector<int> normal(size_t n, double mean, double stddev) const {
+        return fill<int>(n, 3, [=](int* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            std::normal_distribution<double> dist(mean, stddev);
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = static_cast<int>(std::lround(dist(rand_engine)));
+            }
+        });
+    }
+
+    // Nine draws in ten come from a pool of hotValues values, the rest from the full range.
+    std::vector<int> duplicateHeavy(size_t n, int hotValues = 16, int maxVal = 1 << 30) const {
+        return fill<int>(n, 4, [=](int* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            std::uniform_int_distribution<int> hot(0, hotValues - 1);
+            std::uniform_int_distribution<int> cold(0, maxVal);
+            std::uniform_int_distribution<int> pick(0, 9);
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = pick(rand_engine) != 0 ? hot(rand_engine) * (maxVal / hotValues) : cold(rand_engine);
+            }
+        });
+    }
+
+    std::vector<int> fewUnique(size_t n, int unique = 8) const {
+        return fill<int>(n, 5, [=](int* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            std::uniform_int_distribution<int> unif(0, unique - 1);
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = unif(rand_engine);
+            }
+        });
+    }
+
+    std::vector<int> sawtooth(size_t n, size_t period = 1000) const {
+        return fill<int>(n, 6, [=](int* out, size_t begin, size_t end, std::mt19937_64&) {
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = static_cast<int>(i % period);
+            }
+        });
+    }
+
+    std::vector<int> organPipe(size_t n) const {
+        return fill<int>(n, 7, [=](int* out, size_t begin, size_t end, std::mt19937_64&) {
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = static_cast<int>(i < n / 2 ? i : n - 1 - i);
+            }
+        });
+    }
+
+    std::vector<int> reversed(size_t n, int minVal, int maxVal) const {
+        std::vector<int> array = uniform(n, minVal, maxVal);
+        std::sort(array.rbegin(), array.rend());
+        return array;
+    }
+
+    // Sorted uniform values with every swapEvery-th element swapped with its successor.
+    std::vector<int> almostSorted(size_t n, int minVal, int maxVal, size_t swapEvery = 20) const {
+        std::vector<int> array = uniform(n, minVal, maxVal);
+        std::sort(array.begin(), array.end());
+        for (size_t i = 0; i + 1 < n; i += swapEvery) {
+            std::swap(array[i], array[i + 1]);
+        }
+        return array;
+    }
+
+    // Ascending run with k values drawn uniformly and dropped at random positions.
+    std::vector<int> sortedWithRandomInserts(size_t n, size_t k) const {
+        std::vector<int> array = fill<int>(n, 8, [=](int* out, size_t begin, size_t end, std::mt19937_64&) {
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = static_cast<int>(i);
+            }
+        });
+        std::mt19937_64 rand_engine(chunk_seed(8, SIZE_MAX));
+        std::uniform_int_distribution<size_t> position(0, n ? n - 1 : 0);
+        std::uniform_int_distribution<int> value(0, static_cast<int>(std::max<size_t>(n, 1) - 1));
+        for (size_t i = 0; i < k && n > 0; ++i) {
+            array[position(rand_engine)] = value(rand_engine);
+        }
+        return array;
+    }
+
+    // Lengths follow a clamped log-normal, the usual shape of identifiers and log tokens.
+    std::vector<std::string> randomStrings(size_t n, double medianLength = 24, double sigma = 0.6,
+                                           size_t maxLength = 200) const {
+        return fill<std::string>(n, 9, [=](std::string* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            std::lognormal_distribution<double> length(std::log(medianLength), sigma);
+            std::uniform_int_distribution<size_t> symbol(0, charset().size() - 1);
+            for (size_t i = begin; i < end; ++i) {
+                size_t len = std::min<size_t>(maxLength, std::max<size_t>(1, std::lround(length(rand_engine))));
+                out[i].resize(len);
+                for (char& c : out[i]) {
+                    c = charset()[symbol(rand_engine)];
+                }
+            }
+        });
+    }
+
+    std::vector<std::string> urls(size_t n) const {
+        return fill<std::string>(n, 10, [=](std::string* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            ZipfSampler host(hosts().size(), 1.1);
+            ZipfSampler word(words().size(), 0.9);
+            std::uniform_int_distribution<int> depth(1, 5);
+            std::uniform_int_distribution<int> id(0, 999999);
+            for (size_t i = begin; i < end; ++i) {
+                std::string url = "https://" + hosts()[host(rand_engine)];
+                for (int d = depth(rand_engine); d > 0; --d) {
+                    url += "/" + words()[word(rand_engine)];
+                }
+                url += "?id=" + std::to_string(id(rand_engine));
+                out[i] = std::move(url);
+            }
+        });
+    }
+
+    std::vector<std::string> paths(size_t n) const {
+        return fill<std::string>(n, 11, [=](std::string* out, size_t begin, size_t end, std::mt19937_64& rand_engine) {
+            ZipfSampler root(roots().size(), 1.2);
+            ZipfSampler word(words().size(), 0.9);
+            std::uniform_int_distribution<int> depth(2, 8);
+            std::uniform_int_distribution<int> file(0, 9999);
+            for (size_t i = begin; i < end; ++i) {
+                std::string path = roots()[root(rand_engine)];
+                for (int d = depth(rand_engine); d > 0; --d) {
+                    path += "/" + words()[word(rand_engine)];
+                }
+                path += "/file" + std::to_string(file(rand_engine)) + ".log";
+                out[i] = std::move(path);
+            }
+        });
+    }
+
+private:
+    uint64_t seed;
+    unsigned threads;
+
+    static uint64_t splitmix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t chunk_seed(uint64_t stream, uint64_t chunk) const {
+        return splitmix64(splitmix64(seed ^ (stream << 48)) ^ chunk);
+    }
+
+    template <typename T, typename Body>
+    std::vector<T> fill(size_t n, uint64_t stream, Body body) const {
+        std::vector<T> array(n);
+        size_t chunks = (n + chunkSize - 1) / chunkSize;
+        auto work = [&](size_t worker, size_t workers) {
+            for (size_t c = worker; c < chunks; c += workers) {
+                std::mt19937_64 rand_engine(chunk_seed(stream, c));
+                body(array.data(), c * chunkSize, std::min(n, (c + 1) * chunkSize), rand_engine);
+            }
+        };
+        size_t workers = std::min<size_t>(threads, chunks);
+        if (workers <= 1) {
+            work(0, 1);
+            return array;
+        }
+        std::vector<std::thread> pool;
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back(work, w, workers);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+        return array;
+    }
+
+    static const std::string& charset() {
+        static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#%:;^&*()-";
+        return chars;
+    }
+
+    static const std::vector<std::string>& hosts() {
+        static const std::vector<std::string> list = {
+            "www.example.com", "api.example.com", "cdn.example.net", "static.example.org", "shop.example.com",
+            "mail.example.com", "docs.example.io", "blog.example.com", "img.example.net", "auth.example.com"};
+        return list;
+    }
+
+    static const std::vector<std::string>& roots() {
+        static const std::vector<std::string> list = {
+            "/var/log", "/home/user/projects", "/usr/local/share", "/opt/service/data", "/srv/www/htdocs", "/tmp"};
+        return list;
+    }
+
+    static const std::vector<std::string>& words() {
+        static const std::vector<std::string> list = {
+            "api", "v1", "v2", "users", "orders", "items", "search", "images", "static", "assets", "archive",
+            "2024", "2025", "reports", "daily", "config", "cache", "build", "release", "debug", "profile",
+            "settings", "account", "cart", "checkout", "products", "category", "news", "events", "media"};
+        return list;
+    }
+};